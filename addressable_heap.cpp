@@ -0,0 +1,127 @@
+#include "addressable_heap.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+addressable_heap::addressable_heap(std::size_t capacity):
+    positions(capacity, NOT_IN_HEAP)
+{
+    // rows are stored as 32 bit numbers to keep the entries small
+    if (capacity >= NOT_IN_HEAP) {
+        throw std::runtime_error("ERROR : addressable_heap : too many rows");
+    }
+    heap.reserve(capacity);
+}
+
+void addressable_heap::place(std::size_t position, const entry& item)
+{
+    heap[position] = item;
+    positions[item.row] = position;
+}
+
+void addressable_heap::sift_up(std::size_t position)
+{
+    entry item = heap[position];
+    while (position > 0) {
+        std::size_t parent = (position - 1) / HEAP_ARITY;
+        if (!(item.key < heap[parent].key)) {
+            break;
+        }
+        place(position, heap[parent]);
+        position = parent;
+    }
+    place(position, item);
+}
+
+void addressable_heap::sift_down(std::size_t position)
+{
+    entry item = heap[position];
+    while (true) {
+        // find the smallest child
+        std::size_t firstChild = position * HEAP_ARITY + 1;
+        if (firstChild >= heap.size()) {
+            break;
+        }
+        std::size_t lastChild = std::min(firstChild + HEAP_ARITY, heap.size());
+        std::size_t smallest = firstChild;
+        for (std::size_t child = firstChild + 1; child < lastChild; ++child) {
+            if (heap[child].key < heap[smallest].key) {
+                smallest = child;
+            }
+        }
+
+        if (!(heap[smallest].key < item.key)) {
+            break;
+        }
+        place(position, heap[smallest]);
+        position = smallest;
+    }
+    place(position, item);
+}
+
+void addressable_heap::push(std::size_t row, heap_key key)
+{
+    heap.push_back({key, (std::uint32_t)row});
+    positions[row] = heap.size() - 1;
+    sift_up(heap.size() - 1);
+}
+
+std::size_t addressable_heap::top() const
+{
+    return heap.front().row;
+}
+
+const heap_key& addressable_heap::top_key() const
+{
+    return heap.front().key;
+}
+
+void addressable_heap::pop()
+{
+    positions[heap.front().row] = NOT_IN_HEAP;
+    entry last = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+        place(0, last);
+        sift_down(0);
+    }
+}
+
+void addressable_heap::update(std::size_t row, heap_key key)
+{
+    std::size_t position = positions[row];
+    bool smaller = key < heap[position].key;
+    heap[position].key = key;
+    if (smaller) {
+        sift_up(position);
+    } else {
+        sift_down(position);
+    }
+}
+
+void addressable_heap::decrease_key(std::size_t row, heap_key key)
+{
+    std::size_t position = positions[row];
+    heap[position].key = key;
+    sift_up(position);
+}
+
+bool addressable_heap::contains(std::size_t row) const
+{
+    return positions[row] != NOT_IN_HEAP;
+}
+
+const heap_key& addressable_heap::key(std::size_t row) const
+{
+    return heap[positions[row]].key;
+}
+
+bool addressable_heap::empty() const
+{
+    return heap.empty();
+}
+
+std::size_t addressable_heap::size() const
+{
+    return heap.size();
+}
@@ -0,0 +1,67 @@
+#ifndef ADDRESSABLE_HEAP_H
+#define ADDRESSABLE_HEAP_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "types.h"
+
+// a 4-ary heap is shallower than a binary one and keeps the children of a node
+// next to each other, so sifting touches fewer cache lines
+#define HEAP_ARITY 4
+
+// heap keys compare by primary first, then by secondary
+struct heap_key {
+    osp2023::time_type primary;
+    osp2023::time_type secondary;
+
+    bool operator<(const heap_key& other) const {
+        return primary < other.primary || 
+            (primary == other.primary && secondary < other.secondary);
+    }
+};
+
+/**
+ * a d-ary min heap of process rows that remembers where each row is,
+ * so the key of a row already in the heap can be changed in O(log n).
+ * rows go from 0 to the capacity given to the constructor.
+ **/
+class addressable_heap
+{
+    private:
+        struct entry {
+            heap_key key;
+            std::uint32_t row;
+        };
+
+        std::vector<entry> heap;
+        // where each row sits in the heap, NOT_IN_HEAP if it isn't there
+        std::vector<std::uint32_t> positions;
+
+        void place(std::size_t position, const entry& item);
+        void sift_up(std::size_t position);
+        void sift_down(std::size_t position);
+    public:
+        static constexpr std::uint32_t NOT_IN_HEAP = UINT32_MAX;
+
+        // a heap that can hold rows 0 to capacity - 1
+        explicit addressable_heap(std::size_t capacity);
+
+        void push(std::size_t row, heap_key key);
+        // the row with the smallest key, the heap must not be empty
+        std::size_t top() const;
+        const heap_key& top_key() const;
+        void pop();
+
+        // change the key of a row in the heap, moving it up or down as needed
+        void update(std::size_t row, heap_key key);
+        // lowering a key only ever moves the row towards the top
+        void decrease_key(std::size_t row, heap_key key);
+
+        bool contains(std::size_t row) const;
+        const heap_key& key(std::size_t row) const;
+        bool empty() const;
+        std::size_t size() const;
+};
+
+#endif
@@ -0,0 +1,317 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <filesystem>
+#include <streambuf>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "loader.h"
+#include "pcb.h"
+#include "process_table.h"
+#include "types.h"
+#include "simulator.h"
+#include "cmd_options.h"
+#include "workload_generator.h"
+
+// traces go from MIN to MAX processes, multiplying by 10 each time
+#define DEFAULT_MIN_PROCESSES 10
+#define DEFAULT_MAX_PROCESSES 100000000
+#define DEFAULT_REPETITIONS 5
+#define SIZE_STEP 10
+// the same seed every run so the traces are the same every run
+#define BENCH_SEED 2023
+
+#define MIN_PROCESSES_OPTION "--min-processes"
+#define MAX_PROCESSES_OPTION "--max-processes"
+#define REPETITIONS_OPTION "--reps"
+// the policies without a queue version take far longer on the big traces
+// (lottery at quantum 10 is around 25000 ns a process) so they are only run when asked for
+#define ALL_POLICIES_OPTION "--all-policies"
+
+#define PROCESSES_HEADER " Processes "
+#define PHASE_HEADER " Phase "
+#define VARIANT_HEADER " Variant "
+#define QUANTUM_COL_HEADER " Quantum "
+#define NS_PER_PROCESS_HEADER " ns/process "
+#define STD_DEV_HEADER " Std. Dev. "
+#define PEAK_RSS_HEADER " Peak RSS (KiB) "
+#define NUM_BENCH_TABLE_COL 7
+#define NO_QUANTUM "-"
+
+// throws away everything written to it, so printing is timed without the terminal
+class null_buffer : public std::streambuf
+{
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+// one thing to time, the process table is a fresh copy for every repetition
+struct bench_case {
+    std::string phase;
+    std::string variant;
+    std::string quantum;
+    std::function<void(process_table&)> run;
+};
+
+// the mean and standard deviation of the repetitions, in ns per process
+// and the most memory the case had resident, -1 until it's been measured
+struct bench_timing {
+    double mean;
+    double stdDev;
+    long peakRssKib;
+};
+
+bench_timing run_case(const bench_case& benchCase, const process_table& processes,
+    std::size_t repetitions)
+{
+    std::vector<double> samples;
+    for (std::size_t rep = 0; rep < repetitions; ++rep) {
+        // copying the table isn't part of what is being timed
+        process_table copy = processes;
+        auto start = std::chrono::steady_clock::now();
+        benchCase.run(copy);
+        auto end = std::chrono::steady_clock::now();
+
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        samples.push_back(ns / std::max<std::size_t>(1, processes.size()));
+    }
+
+    double mean = 0;
+    for (double sample : samples) {
+        mean += sample;
+    }
+    mean /= samples.size();
+
+    double variance = 0;
+    for (double sample : samples) {
+        variance += (sample - mean) * (sample - mean);
+    }
+    variance /= samples.size();
+
+    return {mean, std::sqrt(variance), -1};
+}
+
+// run the case in a child of its own so the peak memory is only what it used
+// (on top of the processes it started with), the peak of this process only ever grows
+// and would be the same for every case after the biggest one
+bench_timing time_case(const bench_case& benchCase, const process_table& processes,
+    std::size_t repetitions)
+{
+    std::string error = "ERROR : benchmark : " + benchCase.phase + " " + benchCase.variant + " failed";
+    int fds[2];
+    if (pipe(fds) != 0) {
+        throw std::runtime_error(error);
+    }
+
+    // anything still buffered would be written by both processes
+    std::cout.flush();
+    pid_t child = fork();
+    if (child < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        throw std::runtime_error(error);
+    }
+    if (child == 0) {
+        // the timing goes back up the pipe, the child can't return to main
+        close(fds[0]);
+        int status = EXIT_SUCCESS;
+        try {
+            bench_timing timing = run_case(benchCase, processes, repetitions);
+            if (write(fds[1], &timing, sizeof(timing)) != sizeof(timing)) {
+                status = EXIT_FAILURE;
+            }
+        } catch (const std::exception& e) {
+            std::cout << e.what() << std::endl;
+            status = EXIT_FAILURE;
+        }
+        _exit(status);
+    }
+
+    close(fds[1]);
+    bench_timing timing = {0, 0, -1};
+    ssize_t numRead = read(fds[0], &timing, sizeof(timing));
+    close(fds[0]);
+
+    int status = 0;
+    struct rusage usage;
+    if (wait4(child, &status, 0, &usage) != child || !WIFEXITED(status) ||
+        WEXITSTATUS(status) != EXIT_SUCCESS || numRead != sizeof(timing)) {
+        throw std::runtime_error(error);
+    }
+    timing.peakRssKib = usage.ru_maxrss;
+    return timing;
+}
+
+// parse a whole number cmd arg that has to be at least 1
+bool parse_count(const cmd_options& cmd, const std::string& option, std::size_t& count)
+{
+    if (!cmd.has(option)) {
+        return true;
+    }
+    long long value = 0;
+    try {
+        value = std::stoll(cmd.value(option));
+    } catch (const std::exception& e) {
+        std::cout << "ERROR : unable to parse " << option << " cmd arg" << std::endl;
+        return false;
+    }
+    if (value < 1) {
+        std::cout << "ERROR : " << option << " must be at least 1" << std::endl;
+        return false;
+    }
+    count = static_cast<std::size_t>(value);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    // split the options from the plain args
+    // if there is an unknown option exit the program
+    cmd_options cmd({ALL_POLICIES_OPTION}, {MIN_PROCESSES_OPTION, MAX_PROCESSES_OPTION, REPETITIONS_OPTION});
+    try {
+        cmd.parse(argc, argv);
+    } catch (const std::runtime_error& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (!cmd.positional().empty()) {
+        std::string error = "ERROR : incorrect numnber of args : should be ./benchmark"
+            " [--all-policies] [--min-processes <n>] [--max-processes <n>] [--reps <n>]";
+        std::cout << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::size_t minProcesses = DEFAULT_MIN_PROCESSES;
+    std::size_t maxProcesses = DEFAULT_MAX_PROCESSES;
+    std::size_t repetitions = DEFAULT_REPETITIONS;
+    if (!parse_count(cmd, MIN_PROCESSES_OPTION, minProcesses) ||
+        !parse_count(cmd, MAX_PROCESSES_OPTION, maxProcesses) ||
+        !parse_count(cmd, REPETITIONS_OPTION, repetitions)) {
+        return EXIT_FAILURE;
+    }
+
+    // the results are printed in full, but nowhere
+    null_buffer nullBuffer;
+    std::ostream nullOut(&nullBuffer);
+    sim_options printOptions;
+    printOptions.out = &nullOut;
+
+    // each vector implementation next to its queue one, rr at a few quanta
+    bool allPolicies = cmd.has(ALL_POLICIES_OPTION);
+    std::vector<osp2023::time_type> quanta = {pcb::MIN_DURATION, 100, pcb::MAX_DURATION};
+    std::vector<bench_case> scheduleCases = {
+        {"schedule", "fifo", NO_QUANTUM, [](process_table& p) { simulator::schedule_fifo(p); }},
+        {"schedule", "fifo queue", NO_QUANTUM, [](process_table& p) { simulator::schedule_fifo_queue(p); }},
+        {"schedule", "sjf", NO_QUANTUM, [](process_table& p) { simulator::schedule_sjf(p); }},
+        {"schedule", "sjf queue", NO_QUANTUM, [](process_table& p) { simulator::schedule_sjf_queue(p); }},
+    };
+    if (allPolicies) {
+        scheduleCases.push_back({"schedule", "cfs", NO_QUANTUM, [](process_table& p) {
+            simulator::schedule_cfs(CFS_DEFAULT_TARGET_LATENCY, CFS_DEFAULT_MIN_GRANULARITY, p); }});
+    }
+    for (osp2023::time_type quantum : quanta) {
+        std::string quantumStr = std::to_string(quantum);
+        scheduleCases.push_back({"schedule", "rr", quantumStr,
+            [quantum](process_table& p) { simulator::schedule_rr(quantum, p); }});
+        scheduleCases.push_back({"schedule", "rr queue", quantumStr,
+            [quantum](process_table& p) { simulator::schedule_rr_queue(quantum, p); }});
+        if (!allPolicies) {
+            continue;
+        }
+        scheduleCases.push_back({"schedule", "mlfq", quantumStr,
+            [quantum](process_table& p) { 
+                simulator::schedule_mlfq(quantum, MLFQ_DEFAULT_LEVELS, MLFQ_DEFAULT_BOOST, p); }});
+        scheduleCases.push_back({"schedule", "lottery", quantumStr,
+            [quantum](process_table& p) { simulator::schedule_lottery(quantum, LOTTERY_DEFAULT_SEED, p); }});
+        scheduleCases.push_back({"schedule", "stride", quantumStr,
+            [quantum](process_table& p) { simulator::schedule_stride(quantum, p); }});
+    }
+
+    // get the length of each column from the table header
+    std::size_t processesColLen = strlen(PROCESSES_HEADER);
+    std::size_t phaseColLen = strlen(PHASE_HEADER) + 4;
+    std::size_t variantColLen = strlen(VARIANT_HEADER) + 4;
+    std::size_t quantumColLen = strlen(QUANTUM_COL_HEADER);
+    std::size_t nsColLen = strlen(NS_PER_PROCESS_HEADER);
+    std::size_t stdDevColLen = strlen(STD_DEV_HEADER);
+    std::size_t rssColLen = strlen(PEAK_RSS_HEADER);
+    std::size_t rowLen = processesColLen + phaseColLen + variantColLen + quantumColLen +
+        nsColLen + stdDevColLen + rssColLen + NUM_BENCH_TABLE_COL - 1;
+
+    std::cout <<
+        PROCESSES_HEADER << TABLE_VERT_SEP <<
+        std::setw(phaseColLen) << std::left << PHASE_HEADER << TABLE_VERT_SEP <<
+        std::setw(variantColLen) << std::left << VARIANT_HEADER << TABLE_VERT_SEP <<
+        QUANTUM_COL_HEADER << TABLE_VERT_SEP <<
+        NS_PER_PROCESS_HEADER << TABLE_VERT_SEP <<
+        STD_DEV_HEADER << TABLE_VERT_SEP <<
+        PEAK_RSS_HEADER << '\n';
+    std::cout << std::string(rowLen, TABLE_HORZ_SEP) << std::endl;
+
+    auto print_row = [&](std::size_t numProcesses, const bench_case& benchCase, const bench_timing& timing) {
+        std::cout << std::fixed << std::setprecision(2) <<
+            std::setw(processesColLen) << std::left << numProcesses << TABLE_VERT_SEP <<
+            std::setw(phaseColLen) << std::left << benchCase.phase << TABLE_VERT_SEP <<
+            std::setw(variantColLen) << std::left << benchCase.variant << TABLE_VERT_SEP <<
+            std::setw(quantumColLen) << std::left << benchCase.quantum << TABLE_VERT_SEP <<
+            std::setw(nsColLen) << std::left << timing.mean << TABLE_VERT_SEP <<
+            std::setw(stdDevColLen) << std::left << timing.stdDev << TABLE_VERT_SEP <<
+            std::setw(rssColLen) << std::left << timing.peakRssKib << std::endl;
+    };
+
+    std::filesystem::path tempDir = std::filesystem::temp_directory_path();
+    for (std::size_t numProcesses = minProcesses; numProcesses <= maxProcesses; numProcesses *= SIZE_STEP) {
+        // uniform burst times, all arriving at 0
+        workload_spec spec;
+        spec.numProcesses = numProcesses;
+        spec.seed = BENCH_SEED;
+        process_table processes = workload_generator::generate(spec);
+
+        // the loader is timed on the same trace as a CSV file and a binary trace
+        std::string csvFileName = (tempDir / ("osp_bench_" + std::to_string(numProcesses) + ".csv")).string();
+        std::string binFileName = (tempDir / ("osp_bench_" + std::to_string(numProcesses) + ".bin")).string();
+        try {
+            loader::save_csv(csvFileName, processes);
+            loader::save_binary(binFileName, processes);
+
+            std::vector<bench_case> cases = {
+                {"load", "csv", NO_QUANTUM, [&](process_table& p) { p = loader::load(csvFileName); }},
+                {"load", "binary", NO_QUANTUM, [&](process_table& p) { p = loader::load(binFileName); }},
+            };
+            cases.insert(cases.end(), scheduleCases.begin(), scheduleCases.end());
+            // print the fifo results, every policy prints the same amount
+            process_table scheduled = processes;
+            simulator::schedule_fifo(scheduled);
+            for (const bench_case& benchCase : cases) {
+                print_row(numProcesses, benchCase, time_case(benchCase, processes, repetitions));
+            }
+            bench_case printCase = {"print", "table", NO_QUANTUM,
+                [&](process_table& p) { simulator::print_results(p, printOptions); }};
+            print_row(numProcesses, printCase, time_case(printCase, scheduled, repetitions));
+        } catch (const std::exception& e) {
+            std::cout << e.what() << std::endl;
+            std::filesystem::remove(csvFileName);
+            std::filesystem::remove(binFileName);
+            return EXIT_FAILURE;
+        }
+
+        std::filesystem::remove(csvFileName);
+        std::filesystem::remove(binFileName);
+
+        // stop before the size overflows
+        if (numProcesses > maxProcesses / SIZE_STEP) {
+            break;
+        }
+    }
+
+    //exit main
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,68 @@
+#include "buffered_writer.h"
+
+#include <charconv>
+#include <cstring>
+
+buffered_writer::buffered_writer(std::ostream& out):
+    out(out), buffer(WRITER_BUFFER_SIZE), used(0) {};
+
+buffered_writer::~buffered_writer()
+{
+    flush();
+}
+
+void buffered_writer::put(char c)
+{
+    if (used == buffer.size()) {
+        flush();
+    }
+    buffer[used++] = c;
+}
+
+void buffered_writer::write(const char* text, std::size_t length)
+{
+    // anything bigger than the buffer goes straight to the stream
+    if (length > buffer.size() - used) {
+        flush();
+        if (length > buffer.size()) {
+            out.write(text, length);
+            return;
+        }
+    }
+    memcpy(buffer.data() + used, text, length);
+    used += length;
+}
+
+void buffered_writer::fill(char c, std::size_t count)
+{
+    while (count > 0) {
+        if (used == buffer.size()) {
+            flush();
+        }
+        std::size_t chunk = std::min(count, buffer.size() - used);
+        memset(buffer.data() + used, c, chunk);
+        used += chunk;
+        count -= chunk;
+    }
+}
+
+void buffered_writer::write_left(osp2023::time_type value, std::size_t width)
+{
+    // a long long never needs more than 20 characters
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    std::size_t length = result.ptr - digits;
+
+    write(digits, length);
+    if (length < width) {
+        fill(' ', width - length);
+    }
+}
+
+void buffered_writer::flush()
+{
+    if (used > 0) {
+        out.write(buffer.data(), used);
+        used = 0;
+    }
+}
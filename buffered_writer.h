@@ -0,0 +1,44 @@
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+#include <ostream>
+#include <vector>
+#include <cstddef>
+#include "types.h"
+
+#define WRITER_BUFFER_SIZE (1 << 16)
+
+/**
+ * collects output in a fixed size buffer and hands it to the stream in big blocks.
+ * numbers are formatted with std::to_chars, which avoids the locale and
+ * formatting state work an ostream does for every << call.
+ * anything still buffered is written out when the writer is destroyed.
+ **/
+class buffered_writer
+{
+    private:
+        std::ostream& out;
+        std::vector<char> buffer;
+        std::size_t used;
+
+    public:
+        explicit buffered_writer(std::ostream& out);
+        ~buffered_writer();
+
+        buffered_writer(const buffered_writer& other) = delete;
+        buffered_writer& operator=(const buffered_writer& other) = delete;
+
+        void put(char c);
+        void write(const char* text, std::size_t length);
+        // write count copies of c
+        void fill(char c, std::size_t count);
+
+        // write a number left aligned and padded with spaces to width characters,
+        // the same as std::setw(width) << std::left << value
+        void write_left(osp2023::time_type value, std::size_t width);
+
+        // hand everything buffered so far to the stream
+        void flush();
+};
+
+#endif
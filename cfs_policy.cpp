@@ -0,0 +1,49 @@
+#include "cfs_policy.h"
+
+#include <cmath>
+#include <stdexcept>
+
+cfs_policy::cfs_policy(osp2023::time_type targetLatency, osp2023::time_type minGranularity):
+    targetLatency(targetLatency), minGranularity(minGranularity)
+{
+    if (minGranularity < 1) {
+        throw std::runtime_error("ERROR : cfs : min granularity must be at least 1");
+    }
+    if (targetLatency < minGranularity) {
+        throw std::runtime_error("ERROR : cfs : target latency can't be less than the min granularity");
+    }
+}
+
+void cfs_policy::prepare(process_table& processes)
+{
+    weights = processes.getWeights().data();
+    vruntimes.assign(processes.size(), 0);
+    hasRun.assign(processes.size(), false);
+    readyRows.clear();
+    spareNode = {};
+    readyWeight = 0;
+    minVruntime = 0;
+}
+
+osp2023::time_type cfs_policy::slice(std::size_t row, osp2023::time_type remaining)
+{
+    // the running process counts towards the period too
+    std::size_t numRunnable = readyRows.size() + 1;
+    osp2023::weight_type totalWeight = readyWeight + weights[row];
+
+    // stretch the period once the target latency can't fit everyone in
+    osp2023::time_type period = targetLatency;
+    if (numRunnable > static_cast<std::size_t>(targetLatency / minGranularity)) {
+        period = static_cast<osp2023::time_type>(numRunnable) * minGranularity;
+    }
+
+    // this process's share of the period, the weights can be big enough
+    // that period * weight overflows so the share is worked out in floating point
+    osp2023::time_type share = std::llround(
+        static_cast<double>(period) * weights[row] / totalWeight);
+    osp2023::time_type timeElapsed = std::min(std::max(share, minGranularity), remaining);
+
+    // heavier processes age slower, so they get more of the cpu before they're passed
+    vruntimes[row] += (timeElapsed << CFS_VRUNTIME_SHIFT) / weights[row];
+    return timeElapsed;
+}
@@ -0,0 +1,92 @@
+#ifndef CFS_POLICY_H
+#define CFS_POLICY_H
+
+#include <vector>
+#include <set>
+#include <utility>
+#include <cstddef>
+#include <algorithm>
+#include "types.h"
+#include "pcb.h"
+#include "process_table.h"
+
+// every runnable process should get a turn within the target latency
+#define CFS_DEFAULT_TARGET_LATENCY 100
+// but no slice is ever shorter than the min granularity
+#define CFS_DEFAULT_MIN_GRANULARITY pcb::MIN_DURATION
+// vruntime is kept in fixed point with this many fraction bits, so a heavy
+// process still moves forward when it runs for a short time
+#define CFS_VRUNTIME_SHIFT 20
+
+/**
+ * a completely fair scheduler like linux's cfs, a scheduling_policy for simulate<Policy>.
+ * each process has a virtual runtime, the cpu time it has used scaled down by its
+ * weight, and the process with the least vruntime always runs next. the ready
+ * set is a std::set on (vruntime, row), which is a red-black tree, so every pick
+ * and requeue is O(log n) however many processes are runnable.
+ *
+ * the slice is the process's weighted share of the scheduling period, the period is
+ * the target latency unless there are too many runnable processes to give each the
+ * min granularity within it, then it stretches to min granularity per process.
+ **/
+class cfs_policy
+{
+    private:
+        osp2023::time_type targetLatency;
+        osp2023::time_type minGranularity;
+
+        const osp2023::weight_type* weights = nullptr;
+        std::vector<osp2023::time_type> vruntimes;
+        std::vector<char> hasRun;
+
+        std::set<std::pair<osp2023::time_type, std::size_t>> readyRows;
+        // the node of the last row picked, it's reused when a row is ready
+        // again so the tree doesn't allocate on every slice
+        std::set<std::pair<osp2023::time_type, std::size_t>>::node_type spareNode;
+        // the total weight of everything ready
+        osp2023::weight_type readyWeight = 0;
+        // never goes backwards, new processes start here so they can't hog the cpu
+        osp2023::time_type minVruntime = 0;
+    public:
+        // throws if the min granularity is less than 1 or bigger than the target latency
+        cfs_policy(osp2023::time_type targetLatency = CFS_DEFAULT_TARGET_LATENCY,
+            osp2023::time_type minGranularity = CFS_DEFAULT_MIN_GRANULARITY);
+        void prepare(process_table& processes);
+
+        void ready(std::size_t row)
+        {
+            if (!hasRun[row]) {
+                // it just arrived, so it starts level with everything else
+                hasRun[row] = true;
+                vruntimes[row] = minVruntime;
+            }
+            // a row that just ran has usually passed everything, so try the end first
+            if (spareNode) {
+                spareNode.value() = {vruntimes[row], row};
+                readyRows.insert(readyRows.end(), std::move(spareNode));
+            } else {
+                readyRows.emplace_hint(readyRows.end(), vruntimes[row], row);
+            }
+            readyWeight += weights[row];
+        }
+
+        bool empty() const
+        {
+            return readyRows.empty();
+        }
+
+        std::size_t next()
+        {
+            // the leftmost node has the least vruntime
+            auto leftmost = readyRows.begin();
+            std::size_t row = leftmost->second;
+            minVruntime = std::max(minVruntime, leftmost->first);
+            spareNode = readyRows.extract(leftmost);
+            readyWeight -= weights[row];
+            return row;
+        }
+
+        osp2023::time_type slice(std::size_t row, osp2023::time_type remaining);
+};
+
+#endif
@@ -0,0 +1,50 @@
+#include "cmd_options.h"
+
+cmd_options::cmd_options(const std::set<std::string>& flags, 
+    const std::set<std::string>& valueOptions):
+    flags(flags), valueOptions(valueOptions) {};
+
+void cmd_options::parse(int argc, char** argv)
+{
+    std::string prefix = OPTION_PREFIX;
+
+    // skip the program name
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        // anything not starting with the prefix is a plain argument
+        if (arg.compare(0, prefix.length(), prefix) != 0) {
+            args.push_back(arg);
+            continue;
+        }
+
+        if (flags.count(arg) > 0) {
+            options[arg] = "";
+        } else if (valueOptions.count(arg) > 0) {
+            if (i + 1 >= argc) {
+                std::string error = "ERROR : option " + arg + " needs a value";
+                throw std::runtime_error(error);
+            }
+            options[arg] = argv[++i];
+        } else {
+            std::string error = "ERROR : unknown option " + arg;
+            throw std::runtime_error(error);
+        }
+    }
+}
+
+bool cmd_options::has(const std::string& name) const
+{
+    return options.count(name) > 0;
+}
+
+std::string cmd_options::value(const std::string& name) const
+{
+    auto found = options.find(name);
+    return (found == options.end()) ? "" : found->second;
+}
+
+const std::vector<std::string>& cmd_options::positional() const
+{
+    return args;
+}
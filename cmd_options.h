@@ -0,0 +1,43 @@
+#ifndef CMD_OPTIONS_H
+#define CMD_OPTIONS_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <stdexcept>
+
+#define OPTION_PREFIX "--"
+
+/**
+ * splits the command line into "--name" options and the plain arguments.
+ * options can appear anywhere, the plain arguments keep their order and
+ * don't include the program name. an option listed as taking a value
+ * uses the argument after it as that value.
+ **/
+class cmd_options
+{
+    private:
+        std::vector<std::string> args;
+        std::map<std::string, std::string> options;
+        std::set<std::string> flags;
+        std::set<std::string> valueOptions;
+    public:
+        // flags are options on their own, valueOptions are followed by a value
+        cmd_options(const std::set<std::string>& flags, 
+            const std::set<std::string>& valueOptions = {});
+
+        // split up the command line
+        // throws if an option isn't one we know about, or is missing its value
+        void parse(int argc, char** argv);
+
+        // was the option given
+        bool has(const std::string& name) const;
+        // the value given with an option (empty if it wasn't given)
+        std::string value(const std::string& name) const;
+
+        // the plain arguments in order
+        const std::vector<std::string>& positional() const;
+};
+
+#endif
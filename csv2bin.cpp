@@ -0,0 +1,38 @@
+#include <iostream>
+#include <vector>
+
+#include "loader.h"
+#include "pcb.h"
+#include "process_table.h"
+
+#define CSV_FILE_INDEX 1
+#define TRACE_FILE_INDEX 2
+#define NUM_CMD_ARGS 3
+
+int main(int argc, char** argv)
+{
+    // check if the number of cmd arguments is correct
+    // if it doesn't exit the program
+    if (argc != NUM_CMD_ARGS) {
+        std::string error = "ERROR : incorrect numnber of args : should be ./csv2bin <datafile> <tracefile>";
+        std::cout << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // get the file names from cmd args
+    std::string csvFileName = argv[CSV_FILE_INDEX];
+    std::string traceFileName = argv[TRACE_FILE_INDEX];
+
+    try {
+        // parse the CSV once and write it back out as columns
+        process_table processes = loader::load_csv_mmap(csvFileName);
+        loader::save_binary(traceFileName, processes);
+        std::cout << "wrote " << processes.size() << " processes to " << traceFileName << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    //exit main
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,53 @@
+#include "event_queue.h"
+
+#include <algorithm>
+
+namespace {
+    // std heaps put the largest element on top, so "later" is "less"
+    bool later(const sim_event& left, const sim_event& right) {
+        if (left.time != right.time) {
+            return left.time > right.time;
+        }
+        if (left.type != right.type) {
+            return left.type > right.type;
+        }
+        return left.process > right.process;
+    }
+}
+
+event_queue::event_queue() {};
+
+void event_queue::assign(std::vector<sim_event> events)
+{
+    heap = std::move(events);
+    std::make_heap(heap.begin(), heap.end(), later);
+}
+
+void event_queue::push(const sim_event& event)
+{
+    heap.push_back(event);
+    std::push_heap(heap.begin(), heap.end(), later);
+}
+
+sim_event event_queue::pop()
+{
+    std::pop_heap(heap.begin(), heap.end(), later);
+    sim_event event = heap.back();
+    heap.pop_back();
+    return event;
+}
+
+const sim_event& event_queue::top() const
+{
+    return heap.front();
+}
+
+bool event_queue::empty() const
+{
+    return heap.empty();
+}
+
+std::size_t event_queue::size() const
+{
+    return heap.size();
+}
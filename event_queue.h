@@ -0,0 +1,48 @@
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <vector>
+#include <cstddef>
+#include "types.h"
+
+// the things that can happen in a discrete event simulation
+// at the same time, arrivals are handled before what the cpu is doing
+// so a process that arrives as another's quantum expires queues in front of it
+enum class event_type {
+    ARRIVAL = 0,
+    COMPLETION = 1,
+    QUANTUM_EXPIRY = 2
+};
+
+struct sim_event {
+    osp2023::time_type time;
+    event_type type;
+    // the row of the process the event is about
+    std::size_t process;
+};
+
+/**
+ * a binary min heap of events ordered by time, then type, then process row.
+ * push and pop are O(log n) and the earliest event is always on top.
+ **/
+class event_queue
+{
+    private:
+        std::vector<sim_event> heap;
+    public:
+        event_queue();
+
+        // replace the queue with a batch of events, heapified in O(n)
+        void assign(std::vector<sim_event> events);
+
+        void push(const sim_event& event);
+        // remove and return the earliest event
+        sim_event pop();
+        // the earliest event, the queue must not be empty
+        const sim_event& top() const;
+
+        bool empty() const;
+        std::size_t size() const;
+};
+
+#endif
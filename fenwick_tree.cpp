@@ -0,0 +1,56 @@
+#include "fenwick_tree.h"
+
+#include <bit>
+
+fenwick_tree::fenwick_tree(std::size_t size):
+    tree(size + 1, osp2023::time_zero) {};
+
+fenwick_tree::fenwick_tree(const std::vector<osp2023::time_type>& values):
+    tree(values.size() + 1, osp2023::time_zero)
+{
+    // copy the values in, then push each partial sum up to its parent once
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        tree[i + 1] = values[i];
+    }
+    for (std::size_t i = 1; i < tree.size(); ++i) {
+        std::size_t parent = i + (i & (~i + 1));
+        if (parent < tree.size()) {
+            tree[parent] += tree[i];
+        }
+    }
+}
+
+void fenwick_tree::add(std::size_t index, osp2023::time_type delta)
+{
+    for (std::size_t i = index + 1; i < tree.size(); i += i & (~i + 1)) {
+        tree[i] += delta;
+    }
+}
+
+osp2023::time_type fenwick_tree::prefix_sum(std::size_t index) const
+{
+    osp2023::time_type sum = osp2023::time_zero;
+    for (std::size_t i = index; i > 0; i -= i & (~i + 1)) {
+        sum += tree[i];
+    }
+    return sum;
+}
+
+std::size_t fenwick_tree::find(osp2023::time_type target) const
+{
+    // walk down from the biggest block, taking every block that still
+    // doesn't get past target, where we stop is the slot before the answer
+    std::size_t position = 0;
+    for (std::size_t step = std::bit_floor(size()); step > 0; step >>= 1) {
+        if (position + step < tree.size() && tree[position + step] <= target) {
+            position += step;
+            target -= tree[position];
+        }
+    }
+    return position;
+}
+
+std::size_t fenwick_tree::size() const
+{
+    return tree.size() - 1;
+}
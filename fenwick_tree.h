@@ -0,0 +1,41 @@
+#ifndef FENWICK_TREE_H
+#define FENWICK_TREE_H
+
+#include <vector>
+#include <cstddef>
+#include "types.h"
+
+/**
+ * a fenwick (binary indexed) tree over a fixed number of slots.
+ * supports point updates and prefix sums in O(log n), which lets the
+ * simulator answer "how many processes before this one are still running"
+ * without rescanning the process list. find goes the other way, from a
+ * running total to the slot it lands in, which is how a lottery ticket is drawn.
+ **/
+class fenwick_tree
+{
+    private:
+        // 1-based tree storage, slot i lives at tree[i + 1]
+        std::vector<osp2023::time_type> tree;
+    public:
+        // create a tree with size slots all set to zero
+        explicit fenwick_tree(std::size_t size);
+
+        // create a tree with the initial slot values in O(n)
+        explicit fenwick_tree(const std::vector<osp2023::time_type>& values);
+
+        // add delta to the value stored at slot index
+        void add(std::size_t index, osp2023::time_type delta);
+
+        // sum of the slots in [0, index)
+        osp2023::time_type prefix_sum(std::size_t index) const;
+
+        // the first slot whose prefix sum including it is more than target, in O(log n)
+        // the slots can't be negative, returns size() if target is past the total
+        std::size_t find(osp2023::time_type target) const;
+
+        // number of slots in the tree
+        std::size_t size() const;
+};
+
+#endif
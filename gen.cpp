@@ -0,0 +1,73 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+#include "loader.h"
+#include "pcb.h"
+#include "process_table.h"
+#include "workload_generator.h"
+#include "cmd_options.h"
+
+// positions of the plain args, not counting the program name or options
+#define SPEC_INDEX 0
+#define OUT_FILE_INDEX 1
+#define NUM_CMD_ARGS 2
+
+#define BINARY_OPTION "--binary"
+
+int main(int argc, char** argv)
+{
+    // split the options from the plain args
+    // if there is an unknown option exit the program
+    cmd_options cmd({BINARY_OPTION});
+    try {
+        cmd.parse(argc, argv);
+    } catch (const std::runtime_error& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // check if the number of cmd arguments is correct
+    // if it doesn't exit the program
+    if (cmd.positional().size() != NUM_CMD_ARGS) {
+        std::string error = "ERROR : incorrect numnber of args : should be ./gen [--binary] "
+            GEN_SPEC_PREFIX "<distribution>:<processes>[:<seed>[:<mean arrival gap>]] <outfile>";
+        std::cout << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string outFileName = cmd.positional().at(OUT_FILE_INDEX);
+    try {
+        workload_spec spec = workload_generator::parse_spec(cmd.positional().at(SPEC_INDEX));
+
+        if (cmd.has(BINARY_OPTION)) {
+            // the columns of a binary trace are written one after the other
+            // so the whole workload is made first
+            loader::save_binary(outFileName, workload_generator::generate(spec));
+        } else {
+            // a CSV file is written a block at a time, so it never needs
+            // more than one block in memory however big it is
+            std::ofstream file(outFileName, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+            if (!file) {
+                std::string error = "ERROR : gen : could not write to file \"" + outFileName + "\"";
+                throw std::runtime_error(error);
+            }
+            workload_generator generator(spec);
+            process_table batch;
+            while (generator.next_block(batch)) {
+                loader::write_csv(file, batch, spec.meanArrivalGap > 0);
+            }
+            if (!file) {
+                std::string error = "ERROR : gen : could not write to file \"" + outFileName + "\"";
+                throw std::runtime_error(error);
+            }
+        }
+        std::cout << "wrote " << spec.numProcesses << " processes to " << outFileName << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    //exit main
+    return EXIT_SUCCESS;
+}
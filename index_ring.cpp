@@ -0,0 +1,24 @@
+#include "index_ring.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+void index_ring::reserve(std::size_t capacity)
+{
+    if (capacity >= UINT32_MAX) {
+        throw std::runtime_error("ERROR : index_ring : too many rows");
+    }
+    // a queue that is already big enough is just emptied
+    std::size_t numSlots = std::bit_ceil(std::max<std::size_t>(capacity, 1));
+    if (numSlots > mask + 1 || !slots) {
+        slots = std::make_unique_for_overwrite<std::uint32_t[]>(numSlots);
+        mask = numSlots - 1;
+    }
+    head = 0;
+    tail = 0;
+}
+
+std::size_t index_ring::capacity() const
+{
+    return slots ? mask + 1 : 0;
+}
@@ -0,0 +1,55 @@
+#ifndef INDEX_RING_H
+#define INDEX_RING_H
+
+#include <memory>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * a fixed size first in first out queue of row numbers. the slots are one
+ * array made by reserve before the simulation starts, after that pushing and
+ * popping only move the head and tail round it, so the queue never allocates
+ * the way a std::deque does every few hundred rows. rows are kept as 32 bits,
+ * which halves the memory the queue walks over compared to a size_t.
+ **/
+class index_ring
+{
+    private:
+        std::unique_ptr<std::uint32_t[]> slots;
+        // the number of slots is a power of two so wrapping round is a mask
+        std::size_t mask = 0;
+        // head and tail only ever go up, the slot is the count masked
+        std::size_t head = 0;
+        std::size_t tail = 0;
+    public:
+        // make room for at least capacity rows and empty the queue
+        // throws if a row number wouldn't fit in 32 bits
+        void reserve(std::size_t capacity);
+
+        // the caller makes sure there's room, a row is never in a ready queue twice
+        // so reserving one slot per process is always enough
+        void push(std::size_t row)
+        {
+            slots[tail++ & mask] = static_cast<std::uint32_t>(row);
+        }
+
+        std::size_t pop()
+        {
+            return slots[head++ & mask];
+        }
+
+        bool empty() const
+        {
+            return head == tail;
+        }
+
+        std::size_t size() const
+        {
+            return tail - head;
+        }
+
+        std::size_t capacity() const;
+};
+
+#endif
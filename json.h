@@ -0,0 +1,19 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <string>
+
+/**
+ * the bits of json the server answers and the --stats output share.
+ * both are written straight to a stream, so this only does the part that
+ * can't be, turning text that came from outside (ids, paths, error
+ * messages) into a string json readers will accept.
+ **/
+class json
+{
+    public:
+        // quote text as a json string, escaping quotes, backslashes and control characters
+        static std::string quote(const std::string& text);
+};
+
+#endif
@@ -0,0 +1,69 @@
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+latency_histogram::latency_histogram():
+    counts(HISTOGRAM_NUM_BUCKETS, 0), numValues(0), maxValue(osp2023::time_zero) {};
+
+osp2023::time_type latency_histogram::bucket_high(std::size_t bucket)
+{
+    if (bucket < HISTOGRAM_LINEAR_BUCKETS) {
+        return static_cast<osp2023::time_type>(bucket);
+    }
+    // undo bucket(), the values in it share everything above the shift
+    std::size_t above = bucket - HISTOGRAM_LINEAR_BUCKETS;
+    std::size_t shift = above / HISTOGRAM_SUB_BUCKETS + 1;
+    std::uint64_t top = above % HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BUCKETS;
+    return static_cast<osp2023::time_type>(((top + 1) << shift) - 1);
+}
+
+void latency_histogram::merge(const latency_histogram& other)
+{
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    numValues += other.numValues;
+    maxValue = std::max(maxValue, other.maxValue);
+}
+
+std::uint64_t latency_histogram::size() const
+{
+    return numValues;
+}
+
+osp2023::time_type latency_histogram::percentile(double percent) const
+{
+    if (numValues == 0) {
+        return osp2023::time_zero;
+    }
+
+    // the rank of the value we want, counting from 1
+    std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(percent / 100.0 * numValues));
+    rank = std::clamp<std::uint64_t>(rank, 1, numValues);
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            // the top bucket can reach past the biggest value really seen
+            return std::min(bucket_high(i), maxValue);
+        }
+    }
+    return maxValue;
+}
+
+osp2023::time_type latency_histogram::max() const
+{
+    return maxValue;
+}
+
+latency_histogram::report_type latency_histogram::report() const
+{
+    report_type values;
+    for (std::size_t i = 0; i < NUM_REPORTED; ++i) {
+        values[i] = percentile(REPORTED_PERCENTILES[i]);
+    }
+    values[NUM_REPORTED] = maxValue;
+    return values;
+}
@@ -0,0 +1,102 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include "types.h"
+
+// values below 2^8 get a bucket each, above that every power of two is split
+// into 2^7 buckets, so a bucket is never wider than 1/128 of the values in it
+#define HISTOGRAM_LINEAR_BITS 8
+#define HISTOGRAM_LINEAR_BUCKETS (1 << HISTOGRAM_LINEAR_BITS)
+#define HISTOGRAM_SUB_BUCKETS (HISTOGRAM_LINEAR_BUCKETS / 2)
+// enough buckets for every non negative time_type
+#define HISTOGRAM_NUM_BUCKETS (HISTOGRAM_LINEAR_BUCKETS + \
+    (63 - HISTOGRAM_LINEAR_BITS) * HISTOGRAM_SUB_BUCKETS)
+
+/**
+ * an HDR style histogram of times with a bounded relative error. it takes the
+ * same fixed amount of memory however many times go in, and two histograms
+ * can be merged, so runs split over threads or machines can be combined
+ * without keeping every process's times. percentiles are reported as the top
+ * of the bucket they land in, which is within 1/128 (0.8%) of the real value,
+ * and the max is exact.
+ **/
+class latency_histogram
+{
+    private:
+        std::vector<std::uint64_t> counts;
+        std::uint64_t numValues;
+        osp2023::time_type maxValue;
+
+        // the largest value that lands in the bucket
+        static osp2023::time_type bucket_high(std::size_t bucket);
+    public:
+        // the percentiles that get reported, the max goes after them
+        static constexpr std::size_t NUM_REPORTED = 4;
+        static constexpr double REPORTED_PERCENTILES[NUM_REPORTED] = {50.0, 90.0, 99.0, 99.9};
+        static constexpr const char* REPORTED_NAMES[NUM_REPORTED] = {"p50", "p90", "p99", "p99.9"};
+
+        // the reported percentiles followed by the max, small enough to keep once the buckets are gone
+        using report_type = std::array<osp2023::time_type, NUM_REPORTED + 1>;
+
+        latency_histogram();
+
+        // the bucket a value goes in, values below 0 count as 0
+        static std::size_t bucket(osp2023::time_type value)
+        {
+            std::uint64_t bits = (value < 0) ? 0 : static_cast<std::uint64_t>(value);
+            if (bits < HISTOGRAM_LINEAR_BUCKETS) {
+                return bits;
+            }
+            // keep the top HISTOGRAM_LINEAR_BITS - 1 bits below the leading one
+            std::size_t shift = std::bit_width(bits) - HISTOGRAM_LINEAR_BITS;
+            return HISTOGRAM_LINEAR_BUCKETS + (shift - 1) * HISTOGRAM_SUB_BUCKETS +
+                (bits >> shift) - HISTOGRAM_SUB_BUCKETS;
+        }
+
+        // count one value, this is called once per process so it's inline
+        void add(osp2023::time_type value)
+        {
+            ++counts[bucket(value)];
+            ++numValues;
+            maxValue = std::max(maxValue, value);
+        }
+
+        // add the counts of another histogram to this one
+        void merge(const latency_histogram& other);
+
+        std::uint64_t size() const;
+        // the smallest value at least percent of the values are no bigger than, 0 when empty
+        osp2023::time_type percentile(double percent) const;
+        osp2023::time_type max() const;
+        report_type report() const;
+};
+
+// the three times every process ends up with
+struct latency_histograms {
+    latency_histogram wait;
+    latency_histogram turnaround;
+    latency_histogram response;
+
+    void add(osp2023::time_type waitTime, osp2023::time_type turnaroundTime,
+        osp2023::time_type responseTime)
+    {
+        wait.add(waitTime);
+        turnaround.add(turnaroundTime);
+        response.add(responseTime);
+    }
+
+    void merge(const latency_histograms& other)
+    {
+        wait.merge(other.wait);
+        turnaround.merge(other.turnaround);
+        response.merge(other.response);
+    }
+};
+
+#endif
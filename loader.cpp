@@ -1,4 +1,51 @@
 #include "loader.h"
+#include "mapped_file.h"
+#include "trace_format.h"
+#include "buffered_writer.h"
+#include "workload_generator.h"
+
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <thread>
+
+std::string loader::error_message(parse_error error, std::size_t lineNumber)
+{
+    // every loader error names the line it happened on
+    std::string at = " : at line " + std::to_string(lineNumber);
+
+    switch (error) {
+        case parse_error::INCORRECT_NUM_VALUES:
+            return "ERROR : loader : incorrect number of values" + at;
+        case parse_error::BAD_PROCESS_ID:
+            return "ERROR : loader : could not parse processId" + at;
+        case parse_error::PROCESS_ID_TOO_SMALL:
+            return "ERROR : loader : processId cannot be less than " + 
+                std::to_string(MIN_PROCESS_ID) + at;
+        case parse_error::BAD_BURST_TIME:
+            return "ERROR : loader : could not parse burstTime" + at;
+        case parse_error::BURST_TIME_TOO_SMALL:
+            return "ERROR: loader : burstTime cannot be less than " +
+                std::to_string(MIN_BURST_T) + at;
+        case parse_error::BAD_ARRIVAL_TIME:
+            return "ERROR : loader : could not parse arrivalTime" + at;
+        case parse_error::ARRIVAL_TIME_TOO_SMALL:
+            return "ERROR : loader : arrivalTime cannot be less than " +
+                std::to_string(MIN_ARRIVAL_T) + at;
+        case parse_error::BAD_WEIGHT:
+            return "ERROR : loader : could not parse weight" + at;
+        case parse_error::WEIGHT_TOO_SMALL:
+            return "ERROR : loader : weight cannot be less than " +
+                std::to_string(MIN_WEIGHT) + at;
+        case parse_error::WEIGHT_TOO_LARGE:
+            return "ERROR : loader : weight cannot be more than " +
+                std::to_string(MAX_WEIGHT) + at;
+        case parse_error::NONE:
+            break;
+    }
+    return "ERROR : loader : unknown error" + at;
+}
 
 std::vector<std::string> loader::split_string(const std::string& line, char delimiter)
 {
@@ -24,10 +71,9 @@ pcb loader::try_parse_line(const std::string& line, unsigned int lineNumber)
     std::vector<std::string> cells = split_string(line, DELIMITER);
 
     // check if we have the correct number of cells
-    if (cells.size() != NUM_PBT_FIELDS) {
-        std::string error = 
-            "ERROR : loader : incorrect number of values : at line " + std::to_string(lineNumber);
-        throw std::runtime_error(error);
+    if (cells.size() != NUM_PBT_FIELDS && cells.size() != NUM_PBTA_FIELDS && 
+        cells.size() != NUM_PBTAW_FIELDS) {
+        throw std::runtime_error(error_message(parse_error::INCORRECT_NUM_VALUES, lineNumber));
     }
 
     // grab the individual cells
@@ -42,48 +88,74 @@ pcb loader::try_parse_line(const std::string& line, unsigned int lineNumber)
     try {
         processId = std::stoi(processIDStr);
     } catch (const std::exception& e) {
-        std::string error = 
-            "ERROR : loader : could not parse processId : at line " + std::to_string(lineNumber);
-        throw std::runtime_error(error);
+        throw std::runtime_error(error_message(parse_error::BAD_PROCESS_ID, lineNumber));
     }
 
     // check if process id is not less than 1
     if (processId < MIN_PROCESS_ID) {
-        std::string error = 
-            "ERROR : loader : processId cannot be less than " + 
-            std::to_string(MIN_PROCESS_ID) + " : at line " + std::to_string(lineNumber);
-
-        throw std::runtime_error(error);
+        throw std::runtime_error(error_message(parse_error::PROCESS_ID_TOO_SMALL, lineNumber));
     }
 
     // try parse the burstTime
     try {
         burstTime = std::stoul(burstTimeStr);
     } catch (const std::exception& e) {
-        std::string error 
-            = "ERROR : loader : could not parse burstTime : at line " + std::to_string(lineNumber);
-        throw std::runtime_error(error);
+        throw std::runtime_error(error_message(parse_error::BAD_BURST_TIME, lineNumber));
     }
 
     // check if burstTime is not less than 0
     if (burstTime < MIN_BURST_T) {
-        std::string error = 
-            "ERROR: loader : burstTime cannot be less than " +
-            std::to_string(MIN_BURST_T) + " : at line " + std::to_string(lineNumber);
-        throw std::runtime_error(error);
+        throw std::runtime_error(error_message(parse_error::BURST_TIME_TOO_SMALL, lineNumber));
+    }
+
+    // the arrival time is optional, without it the process arrives at the start
+    osp2023::time_type arrivalTime = osp2023::time_zero;
+    if (cells.size() >= NUM_PBTA_FIELDS) {
+        // try parse the arrivalTime
+        try {
+            arrivalTime = std::stoul(cells.at(ARRIVAL_T_INDEX));
+        } catch (const std::exception& e) {
+            throw std::runtime_error(error_message(parse_error::BAD_ARRIVAL_TIME, lineNumber));
+        }
+
+        // check if arrivalTime is not less than 0
+        if (arrivalTime < MIN_ARRIVAL_T) {
+            throw std::runtime_error(error_message(parse_error::ARRIVAL_TIME_TOO_SMALL, lineNumber));
+        }
+    }
+
+    // so is the weight, without it the process gets the default
+    osp2023::weight_type weight = osp2023::default_weight;
+    if (cells.size() == NUM_PBTAW_FIELDS) {
+        // try parse the weight
+        try {
+            weight = std::stoll(cells.at(WEIGHT_INDEX));
+        } catch (const std::exception& e) {
+            throw std::runtime_error(error_message(parse_error::BAD_WEIGHT, lineNumber));
+        }
+
+        // check if weight is not less than 1
+        if (weight < MIN_WEIGHT) {
+            throw std::runtime_error(error_message(parse_error::WEIGHT_TOO_SMALL, lineNumber));
+        }
+
+        // check if weight is not more than the most the policies can add up
+        if (weight > MAX_WEIGHT) {
+            throw std::runtime_error(error_message(parse_error::WEIGHT_TOO_LARGE, lineNumber));
+        }
     }
     
     // instantiate the pair object
-    pcb result(processId, burstTime);
+    pcb result(processId, burstTime, arrivalTime, weight);
 
     // return the pair object
     return result;
 }
 
-std::vector<pcb> loader::load_csv(const std::string& fileName)
+process_table loader::load_csv(const std::string& fileName)
 {
     // store the parsed CSV results
-    std::vector<pcb> result;
+    process_table result;
 
     // open the file
     std::ifstream file(fileName, std::ifstream::in);
@@ -102,7 +174,7 @@ std::vector<pcb> loader::load_csv(const std::string& fileName)
     while (std::getline(file, line))
     {
         pcb row = try_parse_line(line, lineNumber);
-        result.push_back(row);
+        result.push_back(row.getId(), row.getBurstTime(), row.getArrivalTime(), row.getWeight());
         ++lineNumber;
     }
 
@@ -113,3 +185,447 @@ std::vector<pcb> loader::load_csv(const std::string& fileName)
     return result;
 }   
 
+
+bool loader::parse_integer(
+    const char* first, const char* last, bool& negative, unsigned long long& magnitude)
+{
+    // behave like strtol/strtoul (which std::stoi/std::stoul use) so both loaders
+    // accept and reject exactly the same cells:
+    // skip leading whitespace, take an optional sign, then read the digits
+    // anything after the digits is ignored
+    while (first != last && (*first == ' ' || (*first >= '\t' && *first <= '\r'))) {
+        ++first;
+    }
+
+    negative = false;
+    if (first != last && (*first == '+' || *first == '-')) {
+        negative = (*first == '-');
+        ++first;
+    }
+
+    // fails on no digits or a value that does not fit in 64 bits
+    std::from_chars_result parsed = std::from_chars(first, last, magnitude);
+    return parsed.ec == std::errc();
+}
+
+bool loader::parse_time(const char* first, const char* last, osp2023::time_type& time)
+{
+    // std::stoul wraps negative numbers around instead of throwing
+    // and anything past the signed range turns negative when it is stored
+    bool negative = false;
+    unsigned long long magnitude = 0;
+    if (!parse_integer(first, last, negative, magnitude)) {
+        return false;
+    }
+    time = (osp2023::time_type)(negative ? 0 - magnitude : magnitude);
+    return true;
+}
+
+parse_error loader::parse_line(const char* first, const char* last, 
+    osp2023::id_type& processId, osp2023::time_type& burstTime, osp2023::time_type& arrivalTime,
+    osp2023::weight_type& weight)
+{
+    // find where each cell ends, there can be one more delimiter than we have cells
+    // because split_string drops an empty cell after a trailing delimiter
+    // so "1,2," is two cells, "1," is one and an empty line is none
+    const char* cellEnds[NUM_PBTAW_FIELDS + 1];
+    std::size_t numDelimiters = 0;
+    for (const char* cell = first; numDelimiters <= NUM_PBTAW_FIELDS; ++numDelimiters) {
+        const char* delimiter = static_cast<const char*>(memchr(cell, DELIMITER, last - cell));
+        if (delimiter == nullptr) {
+            break;
+        }
+        cellEnds[numDelimiters] = delimiter;
+        cell = delimiter + 1;
+    }
+
+    std::size_t numCells = 0;
+    if (first != last) {
+        numCells = numDelimiters + 1 - (*(last - 1) == DELIMITER ? 1 : 0);
+    }
+    if (numCells != NUM_PBT_FIELDS && numCells != NUM_PBTA_FIELDS && numCells != NUM_PBTAW_FIELDS) {
+        return parse_error::INCORRECT_NUM_VALUES;
+    }
+    // the last cell runs to the end of the line when there's no trailing delimiter
+    if (numDelimiters < numCells) {
+        cellEnds[numDelimiters] = last;
+    }
+
+    bool negative = false;
+    unsigned long long magnitude = 0;
+
+    // std::stoi throws on anything outside the range of an int
+    if (!parse_integer(first, cellEnds[PROCESS_ID_INDEX], negative, magnitude) ||
+        magnitude > (negative ? -(unsigned long long)INT_MIN : (unsigned long long)INT_MAX)) {
+        return parse_error::BAD_PROCESS_ID;
+    }
+    processId = negative ? (osp2023::id_type)(0 - magnitude) : (osp2023::id_type)magnitude;
+    if (processId < MIN_PROCESS_ID) {
+        return parse_error::PROCESS_ID_TOO_SMALL;
+    }
+
+    if (!parse_time(cellEnds[PROCESS_ID_INDEX] + 1, cellEnds[BURST_T_INDEX], burstTime)) {
+        return parse_error::BAD_BURST_TIME;
+    }
+    if (burstTime < MIN_BURST_T) {
+        return parse_error::BURST_TIME_TOO_SMALL;
+    }
+
+    // the arrival time is optional
+    arrivalTime = osp2023::time_zero;
+    if (numCells >= NUM_PBTA_FIELDS) {
+        if (!parse_time(cellEnds[BURST_T_INDEX] + 1, cellEnds[ARRIVAL_T_INDEX], arrivalTime)) {
+            return parse_error::BAD_ARRIVAL_TIME;
+        }
+        if (arrivalTime < MIN_ARRIVAL_T) {
+            return parse_error::ARRIVAL_TIME_TOO_SMALL;
+        }
+    }
+
+    // and so is the weight, parsed like std::stoll would
+    weight = osp2023::default_weight;
+    if (numCells == NUM_PBTAW_FIELDS) {
+        if (!parse_integer(cellEnds[ARRIVAL_T_INDEX] + 1, cellEnds[WEIGHT_INDEX], negative, magnitude) ||
+            magnitude > (negative ? -(unsigned long long)LLONG_MIN : (unsigned long long)LLONG_MAX)) {
+            return parse_error::BAD_WEIGHT;
+        }
+        weight = negative ? (osp2023::weight_type)(0 - magnitude) : (osp2023::weight_type)magnitude;
+        if (weight < MIN_WEIGHT) {
+            return parse_error::WEIGHT_TOO_SMALL;
+        }
+        if (weight > MAX_WEIGHT) {
+            return parse_error::WEIGHT_TOO_LARGE;
+        }
+    }
+
+    return parse_error::NONE;
+}
+
+void loader::parse_chunk(const char* first, const char* last, chunk_result& result)
+{
+    while (first != last) {
+        // find the end of the line, the last line might not have a newline
+        const char* lineEnd = static_cast<const char*>(memchr(first, '\n', last - first));
+        if (lineEnd == nullptr) {
+            lineEnd = last;
+        }
+        ++result.numLines;
+
+        osp2023::id_type processId = 0;
+        osp2023::time_type burstTime = osp2023::time_not_set;
+        osp2023::time_type arrivalTime = osp2023::time_zero;
+        osp2023::weight_type weight = osp2023::default_weight;
+        result.error = parse_line(first, lineEnd, processId, burstTime, arrivalTime, weight);
+        if (result.error != parse_error::NONE) {
+            // stop at the first bad line, later chunks only need our line count
+            return;
+        }
+        result.processes.push_back(processId, burstTime, arrivalTime, weight);
+
+        first = (lineEnd == last) ? last : lineEnd + 1;
+    }
+}
+
+process_table loader::load_csv_mmap(const std::string& fileName)
+{
+    // map the file, if it can't be opened then it does not exist
+    mapped_file file;
+    if (!file.map(fileName)) {
+        std::string error = "ERROR : loader : file \"" + fileName + "\" does not exist";
+        throw std::runtime_error(error);
+    }
+
+    const char* begin = file.data();
+    const char* end = begin + file.size();
+
+    // use as many threads as we have cores, but keep the chunks big enough to be worth it
+    std::size_t numChunks = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    numChunks = std::min(numChunks, std::max<std::size_t>(1, file.size() / MIN_CHUNK_BYTES));
+
+    // cut the file into roughly equal chunks that each start at the beginning of a line
+    std::vector<const char*> bounds = {begin};
+    for (std::size_t i = 1; i < numChunks; ++i) {
+        const char* cut = std::max(bounds.back(), begin + file.size() / numChunks * i);
+        const char* newline = static_cast<const char*>(memchr(cut, '\n', end - cut));
+        bounds.push_back(newline == nullptr ? end : newline + 1);
+    }
+    bounds.push_back(end);
+
+    // parse every chunk on its own thread (the first one on this thread)
+    std::vector<chunk_result> chunks(numChunks);
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < numChunks; ++i) {
+        workers.emplace_back(parse_chunk, bounds[i], bounds[i + 1], std::ref(chunks[i]));
+    }
+    parse_chunk(bounds[0], bounds[1], chunks[0]);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // report the first error in the file, counting lines across the chunks before it
+    std::size_t linesBefore = 0;
+    std::size_t numProcesses = 0;
+    for (const chunk_result& chunk : chunks) {
+        if (chunk.error != parse_error::NONE) {
+            throw std::runtime_error(error_message(chunk.error, linesBefore + chunk.numLines));
+        }
+        linesBefore += chunk.numLines;
+        numProcesses += chunk.processes.size();
+    }
+
+    // stitch the chunks back together in file order
+    process_table result;
+    result.reserve(numProcesses);
+    for (const chunk_result& chunk : chunks) {
+        result.append(chunk.processes);
+    }
+
+    return result;
+}
+
+std::size_t loader::parse_lines(const char* first, const char* last, 
+    process_table& processes, std::size_t linesBefore)
+{
+    chunk_result chunk;
+    parse_chunk(first, last, chunk);
+    if (chunk.error != parse_error::NONE) {
+        throw std::runtime_error(error_message(chunk.error, linesBefore + chunk.numLines));
+    }
+    processes.append(chunk.processes);
+    return chunk.numLines;
+}
+
+process_table loader::load_binary(const std::string& fileName)
+{
+    mapped_file file;
+    if (!file.map(fileName)) {
+        std::string error = "ERROR : loader : file \"" + fileName + "\" does not exist";
+        throw std::runtime_error(error);
+    }
+
+    // the columns are copied across as they are
+    binary_columns columns = map_binary(file, fileName);
+    return copy_binary(columns, 0, columns.numProcesses, fileName);
+}
+
+binary_columns loader::map_binary(const mapped_file& file, const std::string& fileName)
+{
+    // check the header before trusting anything in it
+    trace_header header;
+    if (file.size() < sizeof(header)) {
+        std::string error = "ERROR : loader : file \"" + fileName + "\" is not a binary trace";
+        throw std::runtime_error(error);
+    }
+    memcpy(&header, file.data(), sizeof(header));
+
+    if (memcmp(header.magic, TRACE_MAGIC, TRACE_MAGIC_LEN) != 0) {
+        std::string error = "ERROR : loader : file \"" + fileName + "\" is not a binary trace";
+        throw std::runtime_error(error);
+    }
+    if (header.version != TRACE_VERSION) {
+        std::string error = "ERROR : loader : trace version " + std::to_string(header.version) + 
+            " is not supported : in file \"" + fileName + "\"";
+        throw std::runtime_error(error);
+    }
+    if ((header.columns & TRACE_REQUIRED_COLS) != TRACE_REQUIRED_COLS) {
+        std::string error = "ERROR : loader : trace is missing the id or burst column : in file \"" + 
+            fileName + "\"";
+        throw std::runtime_error(error);
+    }
+    if ((header.columns & ~TRACE_KNOWN_COLS) != 0) {
+        std::string error = "ERROR : loader : trace has unknown columns : in file \"" + 
+            fileName + "\"";
+        throw std::runtime_error(error);
+    }
+
+    // find the columns, they follow each other in the order of their flags
+    std::size_t numProcesses = header.numProcesses;
+    if (numProcesses > file.size()) {
+        std::string error = "ERROR : loader : trace is truncated : in file \"" + fileName + "\"";
+        throw std::runtime_error(error);
+    }
+    std::size_t idOffset = sizeof(header);
+    std::size_t burstOffset = idOffset + trace_column_bytes(numProcesses, sizeof(osp2023::id_type));
+    std::size_t endOffset = burstOffset + trace_column_bytes(numProcesses, sizeof(osp2023::time_type));
+    std::size_t arrivalOffset = endOffset;
+    if (header.columns & TRACE_COL_ARRIVAL) {
+        endOffset += trace_column_bytes(numProcesses, sizeof(osp2023::time_type));
+    }
+    std::size_t weightOffset = endOffset;
+    if (header.columns & TRACE_COL_WEIGHT) {
+        endOffset += trace_column_bytes(numProcesses, sizeof(osp2023::weight_type));
+    }
+
+    // make sure the file is long enough to hold them
+    if (file.size() < endOffset) {
+        std::string error = "ERROR : loader : trace is truncated : in file \"" + fileName + "\"";
+        throw std::runtime_error(error);
+    }
+
+    // the columns are aligned within the file and mmap is page aligned
+    binary_columns columns;
+    columns.numProcesses = numProcesses;
+    columns.ids = reinterpret_cast<const osp2023::id_type*>(file.data() + idOffset);
+    columns.burstTimes = reinterpret_cast<const osp2023::time_type*>(file.data() + burstOffset);
+    if (header.columns & TRACE_COL_ARRIVAL) {
+        columns.arrivalTimes = reinterpret_cast<const osp2023::time_type*>(file.data() + arrivalOffset);
+    }
+    if (header.columns & TRACE_COL_WEIGHT) {
+        columns.weights = reinterpret_cast<const osp2023::weight_type*>(file.data() + weightOffset);
+    }
+    return columns;
+}
+
+
+process_table loader::copy_binary(const binary_columns& columns, 
+    std::size_t begin, std::size_t end, const std::string& fileName)
+{
+    const osp2023::id_type* ids = columns.ids + begin;
+    const osp2023::time_type* burstTimes = columns.burstTimes + begin;
+    const osp2023::time_type* arrivalTimes = 
+        (columns.arrivalTimes == nullptr) ? nullptr : columns.arrivalTimes + begin;
+    const osp2023::weight_type* weights = 
+        (columns.weights == nullptr) ? nullptr : columns.weights + begin;
+    std::size_t numProcesses = end - begin;
+
+    // csv2bin only writes valid traces, but check the bounds in case the file was damaged
+    if (numProcesses > 0 && (*std::min_element(ids, ids + numProcesses) < MIN_PROCESS_ID ||
+        *std::min_element(burstTimes, burstTimes + numProcesses) < MIN_BURST_T ||
+        (arrivalTimes != nullptr && 
+            *std::min_element(arrivalTimes, arrivalTimes + numProcesses) < MIN_ARRIVAL_T) ||
+        (weights != nullptr && 
+            (*std::min_element(weights, weights + numProcesses) < MIN_WEIGHT ||
+            *std::max_element(weights, weights + numProcesses) > MAX_WEIGHT)))) {
+        std::string error = "ERROR : loader : trace has out of range values : in file \"" + 
+            fileName + "\"";
+        throw std::runtime_error(error);
+    }
+
+    // the columns are copied across as they are
+    return process_table(
+        std::vector<osp2023::id_type>(ids, ids + numProcesses),
+        std::vector<osp2023::time_type>(burstTimes, burstTimes + numProcesses),
+        (arrivalTimes == nullptr) ? std::vector<osp2023::time_type>() :
+            std::vector<osp2023::time_type>(arrivalTimes, arrivalTimes + numProcesses),
+        (weights == nullptr) ? std::vector<osp2023::weight_type>() :
+            std::vector<osp2023::weight_type>(weights, weights + numProcesses)
+    );
+}
+
+void loader::write_column(std::ofstream& file, const void* data, 
+    std::size_t numValues, std::size_t valueSize)
+{
+    // write a column followed by the padding that keeps the next one aligned
+    const char padding[TRACE_COL_ALIGN] = {};
+    std::size_t bytes = numValues * valueSize;
+    file.write(static_cast<const char*>(data), bytes);
+    file.write(padding, trace_column_bytes(numValues, valueSize) - bytes);
+}
+
+void loader::save_binary(const std::string& fileName, const process_table& processes)
+{
+    std::ofstream file(fileName, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!file) {
+        std::string error = "ERROR : loader : could not write to file \"" + fileName + "\"";
+        throw std::runtime_error(error);
+    }
+
+    trace_header header = {};
+    memcpy(header.magic, TRACE_MAGIC, TRACE_MAGIC_LEN);
+    header.version = TRACE_VERSION;
+    header.columns = TRACE_REQUIRED_COLS;
+    // leave the arrival times out if they are all 0
+    if (processes.hasArrivalTimes()) {
+        header.columns |= TRACE_COL_ARRIVAL;
+    }
+    // and the weights if they are all the default
+    if (processes.hasWeights()) {
+        header.columns |= TRACE_COL_WEIGHT;
+    }
+    header.numProcesses = processes.size();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // the table already keeps each column contiguous
+    write_column(file, processes.getIds().data(), processes.size(), sizeof(osp2023::id_type));
+    write_column(file, processes.getBurstTimes().data(), processes.size(), sizeof(osp2023::time_type));
+    if (header.columns & TRACE_COL_ARRIVAL) {
+        write_column(file, processes.getArrivalTimes().data(), 
+            processes.size(), sizeof(osp2023::time_type));
+    }
+    if (header.columns & TRACE_COL_WEIGHT) {
+        write_column(file, processes.getWeights().data(), 
+            processes.size(), sizeof(osp2023::weight_type));
+    }
+
+    if (!file) {
+        std::string error = "ERROR : loader : could not write to file \"" + fileName + "\"";
+        throw std::runtime_error(error);
+    }
+}
+
+void loader::save_csv(const std::string& fileName, const process_table& processes)
+{
+    std::ofstream file(fileName, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!file) {
+        std::string error = "ERROR : loader : could not write to file \"" + fileName + "\"";
+        throw std::runtime_error(error);
+    }
+
+    write_csv(file, processes, processes.hasArrivalTimes(), processes.hasWeights());
+
+    if (!file) {
+        std::string error = "ERROR : loader : could not write to file \"" + fileName + "\"";
+        throw std::runtime_error(error);
+    }
+}
+
+void loader::write_csv(std::ostream& out, const process_table& processes, 
+    bool withArrivals, bool withWeights)
+{
+    const std::vector<osp2023::id_type>& ids = processes.getIds();
+    const std::vector<osp2023::time_type>& burstTimes = processes.getBurstTimes();
+    const std::vector<osp2023::time_type>& arrivalTimes = processes.getArrivalTimes();
+    const std::vector<osp2023::weight_type>& weights = processes.getWeights();
+
+    // one "id,burst[,arrival[,weight]]" line per process
+    // the weight is after the arrival time, so it needs the arrival time too
+    withArrivals = withArrivals || withWeights;
+    buffered_writer writer(out);
+    for (std::size_t i = 0; i < processes.size(); ++i) {
+        writer.write_left(ids[i], 0);
+        writer.put(DELIMITER);
+        writer.write_left(burstTimes[i], 0);
+        if (withArrivals) {
+            writer.put(DELIMITER);
+            writer.write_left(arrivalTimes[i], 0);
+        }
+        if (withWeights) {
+            writer.put(DELIMITER);
+            writer.write_left(weights[i], 0);
+        }
+        writer.put('\n');
+    }
+}
+
+process_table loader::load(const std::string& fileName)
+{
+    // synthetic workloads never touch the disk
+    if (workload_generator::is_spec(fileName)) {
+        return workload_generator::generate(workload_generator::parse_spec(fileName));
+    }
+
+    if (is_binary(fileName)) {
+        return load_binary(fileName);
+    }
+    return load_csv_mmap(fileName);
+}
+
+bool loader::is_binary(const std::string& fileName)
+{
+    // peek at the start of the file to see whether it is a binary trace
+    char magic[TRACE_MAGIC_LEN] = {};
+    std::ifstream file(fileName, std::ifstream::in | std::ifstream::binary);
+    file.read(magic, TRACE_MAGIC_LEN);
+    return file.gcount() == TRACE_MAGIC_LEN && 
+        memcmp(magic, TRACE_MAGIC, TRACE_MAGIC_LEN) == 0;
+}
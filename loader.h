@@ -6,24 +6,128 @@
 #define PROCESS_ID_INDEX 0
 #define BURST_T_INDEX 1
 #define NUM_PBT_FIELDS 2
+// the arrival time column is optional
+#define ARRIVAL_T_INDEX 2
+#define NUM_PBTA_FIELDS 3
+// so is the weight column after it
+#define WEIGHT_INDEX 3
+#define NUM_PBTAW_FIELDS 4
 
 #define MIN_PROCESS_ID 1
 #define MIN_BURST_T 0
+#define MIN_ARRIVAL_T 0
+#define MIN_WEIGHT 1
+// weights are summed over every ready process and divide time << 20 in cfs, so
+// the bound keeps the sums well inside 64 bits and a cfs vruntime step at least 1
+#define MAX_WEIGHT (1 << 20)
 
 #include <string>
 #include <vector>
 #include <fstream>
 #include <stdexcept>
 #include <sstream>
+#include <cstddef>
 
 #include "pcb.h"
+#include "process_table.h"
+
+// don't bother splitting the mapped file across threads below this many bytes per chunk
+#define MIN_CHUNK_BYTES (1 << 20)
+
+class mapped_file;
+
+// the columns of a mapped binary trace, they point into the mapping
+struct binary_columns {
+    std::size_t numProcesses = 0;
+    const osp2023::id_type* ids = nullptr;
+    const osp2023::time_type* burstTimes = nullptr;
+    // these are nullptr when the trace doesn't have them
+    const osp2023::time_type* arrivalTimes = nullptr;
+    const osp2023::weight_type* weights = nullptr;
+};
+
+// the reasons a line of the CSV can be rejected
+enum class parse_error {
+    NONE,
+    INCORRECT_NUM_VALUES,
+    BAD_PROCESS_ID,
+    PROCESS_ID_TOO_SMALL,
+    BAD_BURST_TIME,
+    BURST_TIME_TOO_SMALL,
+    BAD_ARRIVAL_TIME,
+    ARRIVAL_TIME_TOO_SMALL,
+    BAD_WEIGHT,
+    WEIGHT_TOO_SMALL,
+    WEIGHT_TOO_LARGE
+};
 
 class loader
 {
     private:
+        // the result of parsing one line aligned chunk of a mapped file
+        struct chunk_result {
+            process_table processes;
+            // number of lines read (up to and including an error line)
+            std::size_t numLines = 0;
+            parse_error error = parse_error::NONE;
+        };
+
         static std::vector<std::string> split_string(const std::string& line, char delimiter);
         static pcb try_parse_line(const std::string& line, unsigned int lineNumber);
+        static std::string error_message(parse_error error, std::size_t lineNumber);
+
+        // parsing straight from the mapped bytes
+        static bool parse_integer(
+            const char* first, const char* last, bool& negative, unsigned long long& magnitude);
+        static bool parse_time(const char* first, const char* last, osp2023::time_type& time);
+        static parse_error parse_line(const char* first, const char* last, 
+            osp2023::id_type& processId, osp2023::time_type& burstTime, 
+            osp2023::time_type& arrivalTime, osp2023::weight_type& weight);
+        static void parse_chunk(const char* first, const char* last, chunk_result& result);
+
+        // write one column of a binary trace followed by its padding
+        static void write_column(std::ofstream& file, const void* data, 
+            std::size_t numValues, std::size_t valueSize);
     public:
-        static std::vector<pcb> load_csv(const std::string& fileName);
+        static process_table load_csv(const std::string& fileName);
+
+        // same as load_csv, but the file is memory mapped and split into line aligned 
+        // chunks that are parsed in parallel, error messages are identical to load_csv
+        static process_table load_csv_mmap(const std::string& fileName);
+
+        // load a binary trace written by save_binary, the columns are read straight
+        // out of the mapped file without any per-record parsing
+        static process_table load_binary(const std::string& fileName);
+
+        // the pieces of the loaders, for reading a trace a batch at a time
+        // parse the lines in [first, last) onto the end of processes, the first one being
+        // line linesBefore + 1 of the file, throws the same errors as load_csv
+        // returns the number of lines read
+        static std::size_t parse_lines(const char* first, const char* last, 
+            process_table& processes, std::size_t linesBefore);
+        // find the columns of a mapped binary trace, throws if the header is bad
+        // or the file is too short for them
+        static binary_columns map_binary(const mapped_file& file, const std::string& fileName);
+        // rows [begin, end) of the columns as a table, throws if any value is out of range
+        static process_table copy_binary(const binary_columns& columns, 
+            std::size_t begin, std::size_t end, const std::string& fileName);
+
+        // write the processes out as a binary trace
+        static void save_binary(const std::string& fileName, const process_table& processes);
+
+        // write the processes out as a CSV file load_csv can read back
+        // arrival times are only written if some process doesn't arrive at 0
+        // and weights if some process doesn't have the default weight
+        static void save_csv(const std::string& fileName, const process_table& processes);
+        // write the CSV lines to a stream, so a file can be written a batch at a time
+        // weights come after the arrival times, so they are written too when there are weights
+        static void write_csv(std::ostream& out, const process_table& processes, 
+            bool withArrivals, bool withWeights = false);
+
+        // load either kind of file, binary traces are recognised by their magic bytes
+        // a gen:... spec makes a synthetic workload in memory instead of reading a file
+        static process_table load(const std::string& fileName);
+        // does the file start with the magic bytes of a binary trace
+        static bool is_binary(const std::string& fileName);
 };
 #endif
\ No newline at end of file
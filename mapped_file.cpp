@@ -0,0 +1,74 @@
+#include "mapped_file.h"
+
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+mapped_file::mapped_file(): bytes(nullptr), length(0) {};
+
+mapped_file::~mapped_file()
+{
+    unmap();
+}
+
+bool mapped_file::map(const std::string& fileName)
+{
+    // drop whatever was mapped before
+    unmap();
+
+    // open the file, if we can't then let the caller report it
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    // find out how much we need to map
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        std::string error = "ERROR : mapped_file : could not stat \"" + fileName + "\"";
+        throw std::runtime_error(error);
+    }
+
+    // mmap refuses zero length mappings, an empty file just has no bytes
+    if (info.st_size == 0) {
+        close(fd);
+        return true;
+    }
+
+    void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping keeps its own reference to the file
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        std::string error = "ERROR : mapped_file : could not map \"" + fileName + "\"";
+        throw std::runtime_error(error);
+    }
+
+    // we read the file front to back
+    madvise(mapping, info.st_size, MADV_SEQUENTIAL);
+
+    bytes = static_cast<const char*>(mapping);
+    length = info.st_size;
+    return true;
+}
+
+void mapped_file::unmap()
+{
+    if (bytes != nullptr) {
+        munmap(const_cast<char*>(bytes), length);
+    }
+    bytes = nullptr;
+    length = 0;
+}
+
+const char* mapped_file::data() const
+{
+    return bytes;
+}
+
+std::size_t mapped_file::size() const
+{
+    return length;
+}
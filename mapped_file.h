@@ -0,0 +1,37 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+/**
+ * a read only memory mapping of a whole file.
+ * the mapping is released when the object goes out of scope,
+ * so the bytes handed out by data() must not outlive it.
+ **/
+class mapped_file
+{
+    private:
+        const char* bytes;
+        std::size_t length;
+
+    public:
+        mapped_file();
+        ~mapped_file();
+
+        // a mapping owns its pages so it can't be copied
+        mapped_file(const mapped_file& other) = delete;
+        mapped_file& operator=(const mapped_file& other) = delete;
+
+        // map the file into memory, returns false if the file can't be opened
+        // throws if the file opened but could not be mapped
+        bool map(const std::string& fileName);
+
+        // release the mapping (safe to call when nothing is mapped)
+        void unmap();
+
+        const char* data() const;
+        std::size_t size() const;
+};
+
+#endif
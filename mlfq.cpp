@@ -0,0 +1,151 @@
+#include <iostream>
+#include <vector>
+#include <optional>
+
+#include "loader.h"
+#include "pcb.h"
+#include "process_table.h"
+#include "types.h"
+#include "simulator.h"
+#include "cmd_options.h"
+#include "stats_recorder.h"
+
+// positions of the plain args, not counting the program name or options
+#define QUANTUM_INDEX 0
+#define FILE_NAME_INDEX 1
+#define NUM_CMD_ARGS 2
+
+#define SUMMARY_ONLY_OPTION "--summary-only"
+#define PERCENTILES_OPTION "--percentiles"
+#define LEVELS_OPTION "--levels"
+#define BOOST_OPTION "--boost"
+#define TIMELINE_OPTION "--timeline"
+#define STATS_OPTION "--stats"
+
+int main(int argc, char** argv)
+{
+    // split the options from the plain args
+    // if there is an unknown option exit the program
+    cmd_options cmd({SUMMARY_ONLY_OPTION, PERCENTILES_OPTION, STATS_OPTION}, {LEVELS_OPTION, BOOST_OPTION, TIMELINE_OPTION});
+    try {
+        cmd.parse(argc, argv);
+    } catch (const std::runtime_error& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // check if the number of cmd arguments is correct
+    // if it doesn't exit the program
+    if (cmd.positional().size() != NUM_CMD_ARGS) {
+        std::string error = "ERROR : incorrect numnber of args : should be ./mlfq [--summary-only] [--percentiles] "
+            "[--levels <n>] [--boost <period>] [--timeline <file> | --stats] <quantum> <datafile>";
+        std::cout << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // try to parse the quantum of the top level
+    osp2023::time_type quantum = osp2023::time_not_set;
+    try {
+        quantum = std::stoll(cmd.positional().at(QUANTUM_INDEX));
+    } catch (const std::exception& e) {
+        std::string error = "ERROR : unable to parse quantum cmd arg";
+        std::cout << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // check if quantum is not negative
+    if (quantum < pcb::MIN_DURATION || quantum > pcb::MAX_DURATION) {
+        std::string error
+            = "ERROR : quantum must be between " +
+            std::to_string(pcb::MIN_DURATION) + " and " + std::to_string(pcb::MAX_DURATION);
+        std::cout << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // try to parse the number of levels
+    long long numLevels = MLFQ_DEFAULT_LEVELS;
+    if (cmd.has(LEVELS_OPTION)) {
+        try {
+            numLevels = std::stoll(cmd.value(LEVELS_OPTION));
+        } catch (const std::exception& e) {
+            std::string error = "ERROR : unable to parse levels cmd arg";
+            std::cout << error << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (numLevels < 1 || numLevels > MLFQ_MAX_LEVELS) {
+            std::string error = "ERROR : levels must be between 1 and " + std::to_string(MLFQ_MAX_LEVELS);
+            std::cout << error << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // try to parse the boost period
+    osp2023::time_type boostPeriod = MLFQ_DEFAULT_BOOST;
+    if (cmd.has(BOOST_OPTION)) {
+        try {
+            boostPeriod = std::stoll(cmd.value(BOOST_OPTION));
+        } catch (const std::exception& e) {
+            std::string error = "ERROR : unable to parse boost cmd arg";
+            std::cout << error << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (boostPeriod < 0) {
+            std::string error = "ERROR : boost can't be negative, 0 turns it off";
+            std::cout << error << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // only one of the ways of running can be picked
+    if (cmd.has(TIMELINE_OPTION) && cmd.has(STATS_OPTION)) {
+        std::string error = "ERROR : only one of --timeline and --stats can be used";
+        std::cout << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // set up how the results are printed
+    sim_options options;
+    options.summary_only = cmd.has(SUMMARY_ONLY_OPTION);
+    options.percentiles = cmd.has(PERCENTILES_OPTION);
+
+    //try to load the processes CSV file or binary trace
+    // the stats time everything from the load onwards
+    std::optional<stats_recorder> stats;
+    if (cmd.has(STATS_OPTION)) {
+        stats.emplace();
+        stats->begin_phase(STATS_PHASE_LOAD);
+    }
+
+    process_table processes;
+    try{
+        processes = loader::load(cmd.positional().at(FILE_NAME_INDEX));
+    } catch(const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    //start the simulation
+    // mlfq goes through simulate, so it handles arrival times itself
+    try {
+        mlfq_policy policy(quantum, numLevels, boostPeriod);
+        if (cmd.has(TIMELINE_OPTION)) {
+            // record every slice handed out and save it when the run is done
+            timeline_recorder timeline;
+            simulator::run(policy, processes, options, timeline);
+            timeline.save(cmd.value(TIMELINE_OPTION));
+        } else if (stats) {
+            // the counts come from a second policy, the first one is used up by the timed run
+            simulator::run_stats(std::move(policy), mlfq_policy(quantum, numLevels, boostPeriod), processes, options, *stats);
+            // the stats go to stderr so the results on stdout stay the same
+            stats->write_json(std::cerr, "mlfq", quantum, processes.size());
+        } else {
+            simulator::run_mlfq(quantum, numLevels, boostPeriod, processes, options);
+        }
+    } catch (const std::runtime_error& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    //exit main
+    return EXIT_SUCCESS;
+}
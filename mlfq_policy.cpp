@@ -0,0 +1,76 @@
+#include "mlfq_policy.h"
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+mlfq_policy::mlfq_policy(osp2023::time_type quantum, std::size_t numLevels,
+    osp2023::time_type boostPeriod): numLevels(numLevels), boostPeriod(boostPeriod)
+{
+    if (numLevels < 1 || numLevels > MLFQ_MAX_LEVELS) {
+        throw std::runtime_error("ERROR : mlfq : levels must be between 1 and " +
+            std::to_string(MLFQ_MAX_LEVELS));
+    }
+    if (quantum < 1) {
+        throw std::runtime_error("ERROR : mlfq : quantum must be at least 1");
+    }
+    if (boostPeriod < 0) {
+        throw std::runtime_error("ERROR : mlfq : boost period can't be negative");
+    }
+
+    // double the quantum on each level down, it stops growing rather than overflowing
+    for (std::size_t level = 0; level < MLFQ_MAX_LEVELS; ++level) {
+        quanta[level] = quantum;
+        if (quantum > std::numeric_limits<osp2023::time_type>::max() / 2) {
+            quantum = std::numeric_limits<osp2023::time_type>::max();
+        } else {
+            quantum *= 2;
+        }
+    }
+}
+
+void mlfq_policy::prepare(process_table& processes)
+{
+    // the queues store rows in 32 bits
+    if (processes.size() >= MLFQ_NO_ROW) {
+        throw std::runtime_error("ERROR : mlfq : too many processes");
+    }
+
+    arrivalTimes = processes.getArrivalTimes().data();
+
+    readyLevels = 0;
+    nextRows.assign(processes.size(), MLFQ_NO_ROW);
+    levels.assign(processes.size(), 0);
+    boosts.assign(processes.size(), 0);
+    boost = 0;
+    hasRun.assign(processes.size(), false);
+
+    clock = osp2023::time_zero;
+    nextBoost = boostPeriod;
+}
+
+void mlfq_policy::boost_all()
+{
+    // every row's level is now out of date, so they are all on the top level
+    ++boost;
+
+    // join the lower levels onto the end of the top one, highest first
+    // so the rows keep the order they would have run in
+    std::uint64_t lowerLevels = readyLevels & ~std::uint64_t(1);
+    while (lowerLevels != 0) {
+        std::size_t level = std::countr_zero(lowerLevels);
+        lowerLevels &= lowerLevels - 1;
+
+        if (readyLevels & 1) {
+            nextRows[tails[0]] = heads[level];
+        } else {
+            heads[0] = heads[level];
+            readyLevels |= 1;
+        }
+        tails[0] = tails[level];
+    }
+    readyLevels &= 1;
+
+    // the next boost is the first one after now, any missed while idle are skipped
+    nextBoost = (clock / boostPeriod + 1) * boostPeriod;
+}
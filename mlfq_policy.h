@@ -0,0 +1,133 @@
+#ifndef MLFQ_POLICY_H
+#define MLFQ_POLICY_H
+
+#include <vector>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include "types.h"
+#include "process_table.h"
+
+// the ready levels are kept in one 64 bit mask, so there can't be more than this
+#define MLFQ_MAX_LEVELS 64
+#define MLFQ_DEFAULT_LEVELS 3
+// every process goes back to the top level this often, 0 never boosts
+#define MLFQ_DEFAULT_BOOST 1000
+// the end of a level's queue
+#define MLFQ_NO_ROW UINT32_MAX
+
+/**
+ * multi-level feedback queue, a scheduling_policy for simulate<Policy>.
+ * every process starts on the top level (0) and drops a level each time it
+ * uses up the whole quantum of its level, the quantum doubles on each level
+ * down. the top non-empty level always runs next, round robin inside it.
+ * every boost period everything goes back to the top level so long jobs
+ * don't starve.
+ *
+ * like the old linux O(1) scheduler each level is a fifo queue threaded
+ * through the rows (the queue is just a next row per row) and a bitmap says
+ * which levels have anything in them, so picking the next process is a
+ * count of trailing zeros and never a scan.
+ **/
+class mlfq_policy
+{
+    private:
+        std::size_t numLevels;
+        std::array<osp2023::time_type, MLFQ_MAX_LEVELS> quanta;
+        osp2023::time_type boostPeriod;
+
+        const osp2023::time_type* arrivalTimes = nullptr;
+
+        // bit l is set when level l has something ready
+        std::uint64_t readyLevels = 0;
+        std::array<std::uint32_t, MLFQ_MAX_LEVELS> heads;
+        std::array<std::uint32_t, MLFQ_MAX_LEVELS> tails;
+        // the row after each row in its level's queue
+        std::vector<std::uint32_t> nextRows;
+
+        // each row's level, only counts if the row's boost matches the
+        // current one, otherwise it was boosted back to the top level since
+        std::vector<std::uint8_t> levels;
+        std::vector<std::uint32_t> boosts;
+        std::uint32_t boost = 0;
+        // each row has run at least once, so being ready again means it used its quantum
+        std::vector<char> hasRun;
+
+        // the time the simulation is up to, worked out from the slices handed
+        // out and the arrival times, and when the next boost is due
+        osp2023::time_type clock = osp2023::time_zero;
+        osp2023::time_type nextBoost;
+
+        std::size_t level_of(std::size_t row) const
+        {
+            return (boosts[row] == boost) ? levels[row] : 0;
+        }
+
+        void push(std::size_t level, std::size_t row)
+        {
+            nextRows[row] = MLFQ_NO_ROW;
+            if (readyLevels & (std::uint64_t(1) << level)) {
+                nextRows[tails[level]] = row;
+            } else {
+                heads[level] = row;
+                readyLevels |= std::uint64_t(1) << level;
+            }
+            tails[level] = row;
+        }
+
+        // move everything ready back to the top level
+        void boost_all();
+    public:
+        // quantum is for the top level, it doubles on each level below
+        // throws if there are no levels or too many, or the quantum or boost don't make sense
+        mlfq_policy(osp2023::time_type quantum, std::size_t numLevels = MLFQ_DEFAULT_LEVELS,
+            osp2023::time_type boostPeriod = MLFQ_DEFAULT_BOOST);
+        void prepare(process_table& processes);
+
+        void ready(std::size_t row)
+        {
+            std::size_t level = 0;
+            if (hasRun[row]) {
+                // it used the whole quantum, so down a level (unless it's already at the bottom)
+                level = std::min(level_of(row) + 1, numLevels - 1);
+            } else {
+                // it just arrived, the cpu can't be earlier than that
+                hasRun[row] = true;
+                clock = std::max(clock, arrivalTimes[row]);
+            }
+            levels[row] = static_cast<std::uint8_t>(level);
+            boosts[row] = boost;
+            push(level, row);
+        }
+
+        bool empty() const
+        {
+            return readyLevels == 0;
+        }
+
+        std::size_t next()
+        {
+            if (boostPeriod > 0 && clock >= nextBoost) {
+                boost_all();
+            }
+            std::size_t level = std::countr_zero(readyLevels);
+            std::size_t row = heads[level];
+            heads[level] = nextRows[row];
+            if (heads[level] == MLFQ_NO_ROW) {
+                readyLevels &= ~(std::uint64_t(1) << level);
+            }
+            return row;
+        }
+
+        osp2023::time_type slice(std::size_t row, osp2023::time_type remaining)
+        {
+            // the same as rr, but with the quantum of the row's level
+            osp2023::time_type timeElapsed = std::min(quanta[level_of(row)], remaining);
+            clock += timeElapsed;
+            return timeElapsed;
+        }
+};
+
+#endif
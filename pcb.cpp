@@ -1,18 +1,14 @@
 #include "pcb.h"
 
 // constructor
-pcb::pcb(osp2023::id_type id, osp2023::time_type burst_time):
-    id(id), burst_time(burst_time), 
+pcb::pcb(osp2023::id_type id, osp2023::time_type burst_time, osp2023::time_type arrival_time,
+    osp2023::weight_type weight):
+    id(id), burst_time(burst_time), arrival_time(arrival_time), weight(weight),
     time_used(osp2023::time_zero),
     wait_time(osp2023::time_not_set), 
     turnaround_time(osp2023::time_not_set),
     response_time(osp2023::time_not_set) {};
 
-// copy constructor for std::sort
-pcb::pcb(const pcb& p) {
-    *this = p;
-};
-
 // printing for debugging
 std::string pcb::to_string() const {
     return "(id: " + std::to_string(id)  + ", total_time: " + std::to_string(burst_time) + ")";
@@ -23,23 +19,6 @@ std::ostream& operator<<(std::ostream& os, const pcb& p) {
     return os;
 }
 
-// assignment operator for std::sort
-pcb& pcb::operator=(const pcb& other) {
-
-    if (this == &other) {
-        return *this;
-    }
-
-    id = other.id;
-    burst_time = other.burst_time;
-    time_used = other.time_used;
-    wait_time = other.wait_time;
-    response_time = other.response_time;
-    turnaround_time = other.turnaround_time;
-
-    return *this;
-}
-
 // getters
 osp2023::id_type pcb::getId() const {
     return id;
@@ -49,6 +28,14 @@ osp2023::time_type pcb::getBurstTime() const {
     return burst_time;
 }
 
+osp2023::time_type pcb::getArrivalTime() const {
+    return arrival_time;
+}
+
+osp2023::weight_type pcb::getWeight() const {
+    return weight;
+}
+
 osp2023::time_type pcb::getWaitTime() const {
     return wait_time;
 }
@@ -17,6 +17,10 @@ class pcb {
         // the total time that a process / job should run for
         // CHANGE: renamed from total_time to burst_time
         osp2023::time_type burst_time;
+        // ADDED: the time the process arrives at the ready queue
+        osp2023::time_type arrival_time;
+        // ADDED: the share of the cpu the process should get under a fair scheduler
+        osp2023::weight_type weight;
         // the time that has been used so far for this process
         osp2023::time_type time_used;
         // the priority level for this process
@@ -36,12 +40,13 @@ class pcb {
         static constexpr osp2023::time_type MIN_DURATION = 10;
 
         // constructor
-        pcb(osp2023::id_type id, osp2023::time_type burst_time);
+        pcb(osp2023::id_type id, osp2023::time_type burst_time, 
+            osp2023::time_type arrival_time = osp2023::time_zero,
+            osp2023::weight_type weight = osp2023::default_weight);
 
-        // copy constructor for std::sort to work
-        pcb(const pcb& p);
-        // assignment operator for std::sort to work
-        pcb& operator=(const pcb& other);
+        // the default copies are all std::sort needs and keep pcb trivially copyable
+        pcb(const pcb& p) = default;
+        pcb& operator=(const pcb& other) = default;
 
         // convert to string
         std::string to_string() const;
@@ -51,6 +56,8 @@ class pcb {
         // getters
         osp2023::id_type getId() const;
         osp2023::time_type getBurstTime() const;
+        osp2023::time_type getArrivalTime() const;
+        osp2023::weight_type getWeight() const;
         osp2023::time_type getWaitTime() const;
         osp2023::time_type getTimeUsed() const;
         osp2023::time_type getResponseTime() const;
@@ -0,0 +1,100 @@
+#include "perf_counters.h"
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+perf_counters::perf_counters()
+{
+    fds.fill(-1);
+
+#ifdef __linux__
+    const std::uint64_t configs[NUM_PERF_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    for (std::size_t i = 0; i < NUM_PERF_COUNTERS; ++i) {
+        // count this process on any cpu, user space only so it works
+        // under the usual perf_event_paranoid setting
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.inherit = 1;
+
+        fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fds[i] == -1 && error.empty()) {
+            error = std::string("perf_event_open failed : ") + strerror(errno);
+        }
+    }
+#else
+    error = "hardware counters are only supported on linux";
+#endif
+}
+
+perf_counters::~perf_counters()
+{
+    for (int fd : fds) {
+        if (fd != -1) {
+            close(fd);
+        }
+    }
+}
+
+const char* perf_counters::name(perf_event event)
+{
+    switch (event) {
+        case perf_event::CYCLES:
+            return "cycles";
+        case perf_event::INSTRUCTIONS:
+            return "instructions";
+        case perf_event::CACHE_MISSES:
+            return "cache_misses";
+        case perf_event::BRANCH_MISSES:
+            return "branch_misses";
+    }
+    return "";
+}
+
+bool perf_counters::available(perf_event event) const
+{
+    return fds[static_cast<std::size_t>(event)] != -1;
+}
+
+bool perf_counters::any_available() const
+{
+    for (int fd : fds) {
+        if (fd != -1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const std::string& perf_counters::unavailable_reason() const
+{
+    return error;
+}
+
+std::array<std::uint64_t, NUM_PERF_COUNTERS> perf_counters::read() const
+{
+    std::array<std::uint64_t, NUM_PERF_COUNTERS> values = {};
+    for (std::size_t i = 0; i < NUM_PERF_COUNTERS; ++i) {
+        if (fds[i] != -1 && ::read(fds[i], &values[i], sizeof(values[i])) != sizeof(values[i])) {
+            values[i] = 0;
+        }
+    }
+    return values;
+}
@@ -0,0 +1,50 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <string>
+#include <cstdint>
+
+#define NUM_PERF_COUNTERS 4
+
+// the hardware events counted, in the order they are read
+enum class perf_event {
+    CYCLES = 0,
+    INSTRUCTIONS = 1,
+    CACHE_MISSES = 2,
+    BRANCH_MISSES = 3
+};
+
+/**
+ * cpu cycles, instructions, cache misses and branch misses for this process
+ * through linux perf_event_open. each counter is opened on its own, so one the
+ * machine can't count (or one we're not allowed to, which is common in
+ * containers) is just missing instead of taking the others with it.
+ * on other systems every counter is missing.
+ **/
+class perf_counters
+{
+    private:
+        std::array<int, NUM_PERF_COUNTERS> fds;
+        // why the first counter that failed couldn't be opened
+        std::string error;
+    public:
+        perf_counters();
+        ~perf_counters();
+
+        perf_counters(const perf_counters& other) = delete;
+        perf_counters& operator=(const perf_counters& other) = delete;
+
+        // the name of a counter as it appears in the stats
+        static const char* name(perf_event event);
+
+        bool available(perf_event event) const;
+        // true if any counter could be opened
+        bool any_available() const;
+        const std::string& unavailable_reason() const;
+
+        // the current value of every counter since they were opened, 0 for missing ones
+        std::array<std::uint64_t, NUM_PERF_COUNTERS> read() const;
+};
+
+#endif
@@ -0,0 +1,140 @@
+#include "policies.h"
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include "thread_pool.h"
+
+void fifo_policy::prepare(process_table& processes)
+{
+    readyRows.reserve(processes.size());
+}
+
+void fifo_policy::fifo_block(const osp2023::time_type* burstTimes, osp2023::time_type* waitTimes,
+    osp2023::time_type* turnaroundTimes, osp2023::time_type* responseTimes,
+    std::size_t begin, std::size_t end, osp2023::time_type startTime)
+{
+    // waitTime = turnaroundTime - burstTime
+    // turnaroundTime = completionTime - arrivalTime
+    // responseTime = firstTime - arrivalTime
+
+    // completionTime = waitTime + burstTime 
+    // because arrival time is all 0 and therefore the CPU is not idling
+
+    // because the CPU does not idle and this is fifo
+    // the completion time for a previous process is the waiting for the current process
+    // therefore waitTimeCurrent = waitTimePrevious + burstTimePrevious
+    // (the first process of the block waits for everything before the block)
+    osp2023::time_type prevCompletion = startTime;
+    for (std::size_t i = begin; i < end; ++i) {
+        waitTimes[i] = prevCompletion;
+
+        // completionTime = waitTime + burstTime
+        // since turnaroundTime = completionTime because arrivalTime = 0
+        // turnaroundTimeCurrent = waitTimeCurrent + burstTimeCurrent
+        prevCompletion += burstTimes[i];
+        turnaroundTimes[i] = prevCompletion;
+
+        // responseTime = firstTime - arrivalTime
+        // because the CPU does not idle and this is fifo
+        // firstTime = waitTime
+        // therefore responseTimeCurrent = waitTimeCurrent
+        // because arrivalTime = 0
+        responseTimes[i] = waitTimes[i];
+    }
+}
+
+void fifo_policy::schedule_all(process_table& processes)
+{
+    const osp2023::time_type* burstTimes = processes.getBurstTimes().data();
+    osp2023::time_type* waitTimes = processes.getWaitTimes().data();
+    osp2023::time_type* turnaroundTimes = processes.getTurnaroundTimes().data();
+    osp2023::time_type* responseTimes = processes.getResponseTimes().data();
+    std::size_t size = processes.size();
+
+    // --- calculate times --- 
+    // the wait times are an exclusive prefix sum of the burst times
+    // on a pool's worker (eg. under run_all) the other cores are already busy
+    if (size < PARALLEL_SCAN_MIN_ROWS || std::thread::hardware_concurrency() < 2 ||
+        thread_pool::on_worker()) {
+        fifo_block(burstTimes, waitTimes, turnaroundTimes, responseTimes, 0, size, osp2023::time_zero);
+        return;
+    }
+
+    // split the table into one block per thread
+    thread_pool pool;
+    std::size_t numBlocks = pool.size();
+    std::size_t blockSize = (size + numBlocks - 1) / numBlocks;
+    std::vector<osp2023::time_type> blockTimes(numBlocks, osp2023::time_zero);
+
+    // first total up the burst times of each block
+    for (std::size_t block = 0; block < numBlocks; ++block) {
+        pool.submit([&, block] {
+            std::size_t begin = std::min(size, block * blockSize);
+            std::size_t end = std::min(size, begin + blockSize);
+            blockTimes[block] = std::reduce(burstTimes + begin, burstTimes + end, osp2023::time_zero);
+        });
+    }
+    pool.wait();
+
+    // each block starts once every block before it has finished
+    std::exclusive_scan(blockTimes.begin(), blockTimes.end(), blockTimes.begin(), osp2023::time_zero);
+
+    // then every block fills in its own times from its start time
+    for (std::size_t block = 0; block < numBlocks; ++block) {
+        pool.submit([&, block] {
+            std::size_t begin = std::min(size, block * blockSize);
+            std::size_t end = std::min(size, begin + blockSize);
+            fifo_block(burstTimes, waitTimes, turnaroundTimes, responseTimes, begin, end, blockTimes[block]);
+        });
+    }
+    pool.wait();
+}
+
+void fifo_queue_policy::prepare(process_table& processes)
+{
+    // every row is in the queue at most once, so one slot each is enough
+    readyQueue.reserve(processes.size());
+}
+
+void sjf_policy::prepare(process_table& processes)
+{
+    // --- sort the processes by burst times (and then the order they appear in) ---
+    // burst times are small integers so a stable radix sort does it in O(n)
+    if (!processes.hasArrivalTimes()) {
+        processes = processes.permute(radix_sort::order(processes.getBurstTimes()));
+    }
+    burstTimes = processes.getBurstTimes().data();
+}
+
+void sjf_policy::schedule_all(process_table& processes)
+{
+    fifo_policy::schedule_all(processes);
+}
+
+void sjf_queue_policy::prepare(process_table& processes)
+{
+    // if everything arrives at 0 the rows become ready in sjf order already
+    lateArrivals = processes.hasArrivalTimes();
+    readyRows.prepare(processes);
+    if (!lateArrivals) {
+        readyQueue.reserve(processes.size());
+    }
+}
+
+rr_policy::rr_policy(osp2023::time_type quantum): quantum(quantum) {};
+
+void rr_policy::prepare(process_table& processes)
+{
+    burstTimes = processes.getBurstTimes().data();
+    isReady.assign(processes.size(), false);
+}
+
+rr_queue_policy::rr_queue_policy(osp2023::time_type quantum): quantum(quantum) {};
+
+void rr_queue_policy::prepare(process_table& processes)
+{
+    // a row that runs out of time has left the queue before it goes back in
+    readyQueue.reserve(processes.size());
+}
+
@@ -0,0 +1,267 @@
+#ifndef POLICIES_H
+#define POLICIES_H
+
+#include <vector>
+#include <queue>
+#include <functional>
+#include <utility>
+#include <cstddef>
+#include "types.h"
+#include "process_table.h"
+#include "policy.h"
+#include "index_ring.h"
+
+// below this many rows fifo times are worked out on one thread
+#define PARALLEL_SCAN_MIN_ROWS (1 << 20)
+
+/**
+ * the vector and queue versions of fifo, sjf and rr as policies for simulate<Policy>.
+ * the vector versions keep their ready processes in plain arrays and fifo/sjf
+ * have a batch kernel for when everything arrives at 0, the queue versions
+ * go through a ring of row numbers (or a heap for sjf) one process at a time,
+ * the ring is made once in prepare so nothing allocates while they run.
+ **/
+
+// first in first out, the batch kernel is a parallel prefix scan of the burst times
+class fifo_policy
+{
+    private:
+        std::vector<std::size_t> readyRows;
+        std::size_t head = 0;
+
+        // fifo times for rows [begin, end) when the cpu is free from startTime
+        static void fifo_block(const osp2023::time_type* burstTimes, osp2023::time_type* waitTimes,
+            osp2023::time_type* turnaroundTimes, osp2023::time_type* responseTimes,
+            std::size_t begin, std::size_t end, osp2023::time_type startTime);
+    public:
+        void prepare(process_table& processes);
+
+        void ready(std::size_t row)
+        {
+            readyRows.push_back(row);
+        }
+
+        bool empty() const
+        {
+            return head == readyRows.size();
+        }
+
+        std::size_t next()
+        {
+            std::size_t row = readyRows[head++];
+            // start the array again once everything in it has run
+            if (head == readyRows.size()) {
+                readyRows.clear();
+                head = 0;
+            }
+            return row;
+        }
+
+        osp2023::time_type slice(std::size_t, osp2023::time_type remaining) const
+        {
+            // fifo runs a process to the end
+            return remaining;
+        }
+
+        // large tables are split into blocks that are scanned on every core,
+        // unless this is already one of a pool's workers
+        static void schedule_all(process_table& processes);
+};
+
+// fifo again through a ring of row numbers
+class fifo_queue_policy
+{
+    private:
+        index_ring readyQueue;
+    public:
+        void prepare(process_table& processes);
+
+        void ready(std::size_t row)
+        {
+            readyQueue.push(row);
+        }
+
+        bool empty() const
+        {
+            return readyQueue.empty();
+        }
+
+        std::size_t next()
+        {
+            return readyQueue.pop();
+        }
+
+        osp2023::time_type slice(std::size_t, osp2023::time_type remaining) const
+        {
+            return remaining;
+        }
+};
+
+// shortest job first, ready processes come out by burst time and then table order
+// when everything arrives at 0 the table is put in sjf order first, like the
+// original, otherwise it keeps its order like the event core
+class sjf_policy
+{
+    private:
+        const osp2023::time_type* burstTimes = nullptr;
+        std::priority_queue<std::pair<osp2023::time_type, std::size_t>,
+            std::vector<std::pair<osp2023::time_type, std::size_t>>,
+            std::greater<std::pair<osp2023::time_type, std::size_t>>> readyRows;
+    public:
+        void prepare(process_table& processes);
+
+        void ready(std::size_t row)
+        {
+            readyRows.push({burstTimes[row], row});
+        }
+
+        bool empty() const
+        {
+            return readyRows.empty();
+        }
+
+        std::size_t next()
+        {
+            std::size_t row = readyRows.top().second;
+            readyRows.pop();
+            return row;
+        }
+
+        osp2023::time_type slice(std::size_t, osp2023::time_type remaining) const
+        {
+            // sjf isn't preemptive
+            return remaining;
+        }
+
+        // once the table is in sjf order the times are the same as fifo's
+        static void schedule_all(process_table& processes);
+};
+
+// sjf again without the batch kernel, through a ring of row numbers
+// rows only need a heap when they arrive out of sjf order
+class sjf_queue_policy
+{
+    private:
+        bool lateArrivals = false;
+        index_ring readyQueue;
+        sjf_policy readyRows;
+    public:
+        void prepare(process_table& processes);
+
+        void ready(std::size_t row)
+        {
+            if (lateArrivals) {
+                readyRows.ready(row);
+            } else {
+                readyQueue.push(row);
+            }
+        }
+
+        bool empty() const
+        {
+            return lateArrivals ? readyRows.empty() : readyQueue.empty();
+        }
+
+        std::size_t next()
+        {
+            if (lateArrivals) {
+                return readyRows.next();
+            }
+            return readyQueue.pop();
+        }
+
+        osp2023::time_type slice(std::size_t, osp2023::time_type remaining) const
+        {
+            return remaining;
+        }
+};
+
+// round robin that sweeps over the table in rounds, running every ready row in turn
+// like the original sweep it never runs a process with nothing to do
+class rr_policy
+{
+    private:
+        osp2023::time_type quantum;
+        const osp2023::time_type* burstTimes = nullptr;
+        std::vector<char> isReady;
+        std::size_t numReady = 0;
+        std::size_t cursor = 0;
+    public:
+        explicit rr_policy(osp2023::time_type quantum);
+        void prepare(process_table& processes);
+
+        void ready(std::size_t row)
+        {
+            // a process with a burst time of 0 is already done, so the sweep skips it
+            // and its times are never set
+            if (burstTimes[row] == osp2023::time_zero) {
+                return;
+            }
+            isReady[row] = true;
+            ++numReady;
+        }
+
+        bool empty() const
+        {
+            return numReady == 0;
+        }
+
+        std::size_t next()
+        {
+            // carry on round the table from the last row that ran
+            while (!isReady[cursor]) {
+                if (++cursor == isReady.size()) {
+                    cursor = 0;
+                }
+            }
+            std::size_t row = cursor;
+            isReady[row] = false;
+            --numReady;
+            if (++cursor == isReady.size()) {
+                cursor = 0;
+            }
+            return row;
+        }
+
+        osp2023::time_type slice(std::size_t, osp2023::time_type remaining) const
+        {
+            // if adding the quantum doesn't end the process or just barely
+            // then the elapsed time will be the quantum time
+            // if adding the quantum ends the process (and not barely)
+            // then the elapsed time will the difference between burst time and used time
+            return std::min(quantum, remaining);
+        }
+};
+
+// round robin again through a ring of row numbers
+class rr_queue_policy
+{
+    private:
+        osp2023::time_type quantum;
+        index_ring readyQueue;
+    public:
+        explicit rr_queue_policy(osp2023::time_type quantum);
+        void prepare(process_table& processes);
+
+        void ready(std::size_t row)
+        {
+            readyQueue.push(row);
+        }
+
+        bool empty() const
+        {
+            return readyQueue.empty();
+        }
+
+        std::size_t next()
+        {
+            return readyQueue.pop();
+        }
+
+        osp2023::time_type slice(std::size_t, osp2023::time_type remaining) const
+        {
+            return std::min(quantum, remaining);
+        }
+};
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef POLICY_H
+#define POLICY_H
+
+#include <vector>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include "types.h"
+#include "process_table.h"
+#include "radix_sort.h"
+
+/**
+ * a scheduling policy decides which ready process runs next and for how long.
+ * simulate<Policy> below owns the loop and works out every time from those
+ * decisions, so a new policy is just its ready set. the policy is a template
+ * parameter, so each policy gets its own copy of the loop with no virtual calls.
+ *
+ *   prepare(table)  called once before anything is ready, may reorder the table
+ *   ready(row)      row has arrived, or ran out of time and is waiting again
+ *   empty()         is anything ready
+ *   next()          take the next row to run out of the ready set
+ *   slice(row, r)   how long row runs for now, r is the time it has left
+ **/
+template <typename Policy>
+concept scheduling_policy = requires(Policy policy, process_table& processes,
+    std::size_t row, osp2023::time_type remaining) {
+    policy.prepare(processes);
+    policy.ready(row);
+    { policy.empty() } -> std::convertible_to<bool>;
+    { policy.next() } -> std::convertible_to<std::size_t>;
+    { policy.slice(row, remaining) } -> std::convertible_to<osp2023::time_type>;
+};
+
+// a policy that can also fill in every time in one go when everything arrives at 0
+template <typename Policy>
+concept batch_policy = scheduling_policy<Policy> && requires(Policy policy, process_table& processes) {
+    policy.schedule_all(processes);
+};
+
+/**
+ * something told about every slice of cpu time simulate hands out.
+ * enabled is false for a recorder that throws everything away, so the
+ * calls can be compiled out and batch policies can skip the loop.
+ *
+ *   prepared(table)                  the policy has prepared the table, the loop starts next
+ *   record(row, id, start, end, f)   row ran from start to end, f if it finished
+ **/
+template <typename Recorder>
+concept dispatch_recorder = requires(Recorder recorder, const process_table& processes,
+    std::size_t row, osp2023::id_type process, osp2023::time_type start, 
+    osp2023::time_type end, bool finished) {
+    { Recorder::enabled } -> std::convertible_to<bool>;
+    recorder.prepared(processes);
+    recorder.record(row, process, start, end, finished);
+};
+
+// the default recorder, which records nothing and costs nothing
+class null_recorder
+{
+    public:
+        static constexpr bool enabled = false;
+        void prepared(const process_table&) {}
+        void record(std::size_t, osp2023::id_type, osp2023::time_type, osp2023::time_type, bool) {}
+};
+
+// run the processes under the policy and fill in their times
+// every slice handed out is passed on to the recorder
+template <scheduling_policy Policy, dispatch_recorder Recorder>
+void simulate(Policy& policy, process_table& processes, Recorder& recorder)
+{
+    policy.prepare(processes);
+    recorder.prepared(processes);
+
+    // a batch policy skips the loop when nothing arrives late
+    // unless the slices are being recorded, which needs the loop
+    if constexpr (batch_policy<Policy> && !Recorder::enabled) {
+        if (!processes.hasArrivalTimes()) {
+            policy.schedule_all(processes);
+            return;
+        }
+    }
+
+    const osp2023::id_type* ids = processes.getIds().data();
+    const osp2023::time_type* burstTimes = processes.getBurstTimes().data();
+    const osp2023::time_type* arrivalTimes = processes.getArrivalTimes().data();
+    osp2023::time_type* timesUsed = processes.getTimesUsed().data();
+    osp2023::time_type* waitTimes = processes.getWaitTimes().data();
+    osp2023::time_type* turnaroundTimes = processes.getTurnaroundTimes().data();
+    osp2023::time_type* responseTimes = processes.getResponseTimes().data();
+
+    // the processes in the order they arrive, ties in table order
+    // if they all arrive at 0 they are all ready straight away
+    bool lateArrivals = processes.hasArrivalTimes();
+    std::vector<std::size_t> arrivals;
+    if (lateArrivals) {
+        arrivals = radix_sort::order(processes.getArrivalTimes());
+    } else {
+        for (std::size_t i = 0; i < processes.size(); ++i) {
+            policy.ready(i);
+        }
+    }
+    std::size_t nextArrival = 0;
+
+    // everything that has arrived by time joins the ready set
+    auto admit = [&](osp2023::time_type time) {
+        while (nextArrival < arrivals.size() && arrivalTimes[arrivals[nextArrival]] <= time) {
+            policy.ready(arrivals[nextArrival]);
+            ++nextArrival;
+        }
+    };
+
+    osp2023::time_type curr_completion = osp2023::time_zero;
+    while (true) {
+        if (lateArrivals) {
+            admit(curr_completion);
+        }
+        if (policy.empty()) {
+            // nothing to run, so the cpu idles until the next arrival
+            if (nextArrival == arrivals.size()) {
+                break;
+            }
+            curr_completion = std::max(curr_completion, arrivalTimes[arrivals[nextArrival]]);
+            continue;
+        }
+
+        std::size_t row = policy.next();
+
+        // responseTime = firstTime - arrivalTime
+        if (responseTimes[row] == osp2023::time_not_set) {
+            responseTimes[row] = curr_completion - arrivalTimes[row];
+        }
+
+        // elapse the time the policy gives it
+        osp2023::time_type timeElapsed = policy.slice(row, burstTimes[row] - timesUsed[row]);
+        curr_completion += timeElapsed;
+        timesUsed[row] += timeElapsed;
+
+        bool finished = timesUsed[row] == burstTimes[row];
+        if constexpr (Recorder::enabled) {
+            recorder.record(row, ids[row], curr_completion - timeElapsed, curr_completion, finished);
+        }
+
+        if (finished) {
+            // turnaroundTime = completionTime - arrivalTime
+            turnaroundTimes[row] = curr_completion - arrivalTimes[row];
+            // waitTime = turnaroundTime - burstTime
+            waitTimes[row] = turnaroundTimes[row] - burstTimes[row];
+        } else {
+            // anything that arrived while it ran gets in line first
+            if (lateArrivals) {
+                admit(curr_completion);
+            }
+            policy.ready(row);
+        }
+    }
+}
+
+// the same without recording anything
+template <scheduling_policy Policy>
+void simulate(Policy& policy, process_table& processes)
+{
+    null_recorder recorder;
+    simulate(policy, processes, recorder);
+}
+
+#endif
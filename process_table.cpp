@@ -0,0 +1,182 @@
+#include "process_table.h"
+
+#include <algorithm>
+
+process_table::process_table(): has_arrival_times(false), has_weights(false) {};
+
+process_table::process_table(std::vector<osp2023::id_type> ids, 
+    std::vector<osp2023::time_type> burstTimes, std::vector<osp2023::time_type> arrivalTimes,
+    std::vector<osp2023::weight_type> weights):
+    ids(std::move(ids)), burst_times(std::move(burstTimes)),
+    arrival_times(std::move(arrivalTimes)), has_arrival_times(false),
+    weights(std::move(weights)), has_weights(false),
+    times_used(burst_times.size(), osp2023::time_zero),
+    wait_times(burst_times.size(), osp2023::time_not_set),
+    turnaround_times(burst_times.size(), osp2023::time_not_set),
+    response_times(burst_times.size(), osp2023::time_not_set)
+{
+    // no arrival times means they all arrive at the start
+    if (arrival_times.empty()) {
+        arrival_times.resize(burst_times.size(), osp2023::time_zero);
+    }
+    has_arrival_times = std::any_of(arrival_times.begin(), arrival_times.end(),
+        [](osp2023::time_type arrivalTime) { return arrivalTime != osp2023::time_zero; });
+
+    // the same for weights, which are all the default without any
+    if (this->weights.empty()) {
+        this->weights.resize(burst_times.size(), osp2023::default_weight);
+    }
+    has_weights = std::any_of(this->weights.begin(), this->weights.end(),
+        [](osp2023::weight_type weight) { return weight != osp2023::default_weight; });
+}
+
+void process_table::push_back(osp2023::id_type id, osp2023::time_type burstTime, 
+    osp2023::time_type arrivalTime, osp2023::weight_type weight)
+{
+    ids.push_back(id);
+    burst_times.push_back(burstTime);
+    arrival_times.push_back(arrivalTime);
+    has_arrival_times = has_arrival_times || arrivalTime != osp2023::time_zero;
+    weights.push_back(weight);
+    has_weights = has_weights || weight != osp2023::default_weight;
+    times_used.push_back(osp2023::time_zero);
+    wait_times.push_back(osp2023::time_not_set);
+    turnaround_times.push_back(osp2023::time_not_set);
+    response_times.push_back(osp2023::time_not_set);
+}
+
+void process_table::append(const process_table& other)
+{
+    ids.insert(ids.end(), other.ids.begin(), other.ids.end());
+    burst_times.insert(burst_times.end(), other.burst_times.begin(), other.burst_times.end());
+    arrival_times.insert(arrival_times.end(), other.arrival_times.begin(), other.arrival_times.end());
+    has_arrival_times = has_arrival_times || other.has_arrival_times;
+    weights.insert(weights.end(), other.weights.begin(), other.weights.end());
+    has_weights = has_weights || other.has_weights;
+    times_used.insert(times_used.end(), other.times_used.begin(), other.times_used.end());
+    wait_times.insert(wait_times.end(), other.wait_times.begin(), other.wait_times.end());
+    turnaround_times.insert(turnaround_times.end(), 
+        other.turnaround_times.begin(), other.turnaround_times.end());
+    response_times.insert(response_times.end(), 
+        other.response_times.begin(), other.response_times.end());
+}
+
+void process_table::reserve(std::size_t size)
+{
+    ids.reserve(size);
+    burst_times.reserve(size);
+    arrival_times.reserve(size);
+    weights.reserve(size);
+    times_used.reserve(size);
+    wait_times.reserve(size);
+    turnaround_times.reserve(size);
+    response_times.reserve(size);
+}
+
+std::size_t process_table::size() const
+{
+    return ids.size();
+}
+
+bool process_table::empty() const
+{
+    return ids.empty();
+}
+
+bool process_table::hasArrivalTimes() const
+{
+    return has_arrival_times;
+}
+
+bool process_table::hasWeights() const
+{
+    return has_weights;
+}
+
+pcb process_table::row(std::size_t index) const
+{
+    pcb result(ids[index], burst_times[index], arrival_times[index], weights[index]);
+    result.setTimeUsed(times_used[index]);
+    result.setWaitTime(wait_times[index]);
+    result.setTurnaroundTime(turnaround_times[index]);
+    result.setResponseTime(response_times[index]);
+    return result;
+}
+
+process_table process_table::permute(const std::vector<std::size_t>& order) const
+{
+    process_table result;
+    result.ids.resize(order.size());
+    result.burst_times.resize(order.size());
+    result.arrival_times.resize(order.size());
+    result.has_arrival_times = has_arrival_times;
+    result.weights.resize(order.size());
+    result.has_weights = has_weights;
+    result.times_used.resize(order.size());
+    result.wait_times.resize(order.size());
+    result.turnaround_times.resize(order.size());
+    result.response_times.resize(order.size());
+
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        std::size_t from = order[i];
+        result.ids[i] = ids[from];
+        result.burst_times[i] = burst_times[from];
+        result.arrival_times[i] = arrival_times[from];
+        result.weights[i] = weights[from];
+        result.times_used[i] = times_used[from];
+        result.wait_times[i] = wait_times[from];
+        result.turnaround_times[i] = turnaround_times[from];
+        result.response_times[i] = response_times[from];
+    }
+
+    return result;
+}
+
+// getters
+const std::vector<osp2023::id_type>& process_table::getIds() const {
+    return ids;
+}
+
+const std::vector<osp2023::time_type>& process_table::getBurstTimes() const {
+    return burst_times;
+}
+
+const std::vector<osp2023::time_type>& process_table::getArrivalTimes() const {
+    return arrival_times;
+}
+
+const std::vector<osp2023::weight_type>& process_table::getWeights() const {
+    return weights;
+}
+
+const std::vector<osp2023::time_type>& process_table::getTimesUsed() const {
+    return times_used;
+}
+
+const std::vector<osp2023::time_type>& process_table::getWaitTimes() const {
+    return wait_times;
+}
+
+const std::vector<osp2023::time_type>& process_table::getTurnaroundTimes() const {
+    return turnaround_times;
+}
+
+const std::vector<osp2023::time_type>& process_table::getResponseTimes() const {
+    return response_times;
+}
+
+std::vector<osp2023::time_type>& process_table::getTimesUsed() {
+    return times_used;
+}
+
+std::vector<osp2023::time_type>& process_table::getWaitTimes() {
+    return wait_times;
+}
+
+std::vector<osp2023::time_type>& process_table::getTurnaroundTimes() {
+    return turnaround_times;
+}
+
+std::vector<osp2023::time_type>& process_table::getResponseTimes() {
+    return response_times;
+}
@@ -0,0 +1,86 @@
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include <vector>
+#include <cstddef>
+#include "pcb.h"
+#include "types.h"
+
+/**
+ * the processes of a trace stored as a structure of arrays.
+ * each pcb field lives in its own contiguous column so the scheduling loops
+ * stream through plain arrays of integers, and copying a table for each
+ * algorithm is six memcpys instead of a pcb copy per process.
+ * row i of every column belongs to the i-th process of the table.
+ **/
+class process_table
+{
+    private:
+        // the unique process ids
+        std::vector<osp2023::id_type> ids;
+        // the total time each process should run for
+        std::vector<osp2023::time_type> burst_times;
+        // the time each process arrives, all 0 unless the trace gave them
+        std::vector<osp2023::time_type> arrival_times;
+        // true once any process arrives after time 0
+        bool has_arrival_times;
+        // the weight of each process, all the default unless the trace gave them
+        std::vector<osp2023::weight_type> weights;
+        // true once any process has a weight other than the default
+        bool has_weights;
+        // the time each process has used so far
+        std::vector<osp2023::time_type> times_used;
+        // the results of the simulation
+        std::vector<osp2023::time_type> wait_times;
+        std::vector<osp2023::time_type> turnaround_times;
+        std::vector<osp2023::time_type> response_times;
+
+    public:
+        // an empty table
+        process_table();
+
+        // a table of processes that haven't been simulated yet
+        // the arrival times can be left empty if every process arrives at 0
+        // and the weights if every process has the default weight
+        process_table(std::vector<osp2023::id_type> ids, std::vector<osp2023::time_type> burstTimes,
+            std::vector<osp2023::time_type> arrivalTimes = {}, 
+            std::vector<osp2023::weight_type> weights = {});
+
+        // add a process that hasn't been simulated yet
+        void push_back(osp2023::id_type id, osp2023::time_type burstTime, 
+            osp2023::time_type arrivalTime = osp2023::time_zero,
+            osp2023::weight_type weight = osp2023::default_weight);
+        // add every row of another table to the end of this one
+        void append(const process_table& other);
+        void reserve(std::size_t size);
+
+        std::size_t size() const;
+        bool empty() const;
+        // does any process arrive after time 0
+        bool hasArrivalTimes() const;
+        // does any process have a weight other than the default
+        bool hasWeights() const;
+
+        // a copy of row index as a pcb, handy for printing and debugging
+        pcb row(std::size_t index) const;
+
+        // a copy of the table with its rows reordered, row i of the result is row order[i]
+        process_table permute(const std::vector<std::size_t>& order) const;
+
+        // the columns, the simulator works on these directly
+        const std::vector<osp2023::id_type>& getIds() const;
+        const std::vector<osp2023::time_type>& getBurstTimes() const;
+        const std::vector<osp2023::time_type>& getArrivalTimes() const;
+        const std::vector<osp2023::weight_type>& getWeights() const;
+        const std::vector<osp2023::time_type>& getTimesUsed() const;
+        const std::vector<osp2023::time_type>& getWaitTimes() const;
+        const std::vector<osp2023::time_type>& getTurnaroundTimes() const;
+        const std::vector<osp2023::time_type>& getResponseTimes() const;
+
+        std::vector<osp2023::time_type>& getTimesUsed();
+        std::vector<osp2023::time_type>& getWaitTimes();
+        std::vector<osp2023::time_type>& getTurnaroundTimes();
+        std::vector<osp2023::time_type>& getResponseTimes();
+};
+
+#endif
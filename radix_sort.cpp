@@ -0,0 +1,140 @@
+#include "radix_sort.h"
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include "thread_pool.h"
+
+std::vector<std::uint64_t> radix_sort::offset_keys(const std::vector<osp2023::time_type>& keys,
+    std::size_t& numPasses)
+{
+    std::vector<std::uint64_t> offsetKeys(keys.size());
+    numPasses = 0;
+    if (keys.empty()) {
+        return offsetKeys;
+    }
+
+    // shift the keys so negative ones still sort as unsigned
+    osp2023::time_type minKey = *std::min_element(keys.begin(), keys.end());
+    std::uint64_t maxOffset = 0;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        offsetKeys[i] = static_cast<std::uint64_t>(keys[i]) - static_cast<std::uint64_t>(minKey);
+        maxOffset = std::max(maxOffset, offsetKeys[i]);
+    }
+
+    // one pass per digit of the largest key, none if every key is the same
+    while (numPasses * RADIX_BITS < 64 && (maxOffset >> (numPasses * RADIX_BITS)) != 0) {
+        ++numPasses;
+    }
+    return offsetKeys;
+}
+
+std::vector<std::size_t> radix_sort::order(const std::vector<osp2023::time_type>& keys)
+{
+    // a sort on a pool's worker stays on it rather than starting a pool of its own
+    if (keys.size() < PARALLEL_SORT_MIN_ROWS || std::thread::hardware_concurrency() < 2 ||
+        thread_pool::on_worker()) {
+        return order_serial(keys);
+    }
+    return order_parallel(keys);
+}
+
+std::vector<std::size_t> radix_sort::order_serial(const std::vector<osp2023::time_type>& keys)
+{
+    std::size_t numPasses = 0;
+    std::vector<std::uint64_t> sortKeys = offset_keys(keys, numPasses);
+    std::vector<std::size_t> rows(keys.size());
+    std::iota(rows.begin(), rows.end(), 0);
+
+    // the keys move along with the rows so each pass reads them in order
+    std::vector<std::uint64_t> nextKeys(numPasses > 0 ? keys.size() : 0);
+    std::vector<std::size_t> nextRows(numPasses > 0 ? keys.size() : 0);
+    std::vector<std::size_t> offsets(RADIX_BUCKETS);
+
+    for (std::size_t pass = 0; pass < numPasses; ++pass) {
+        std::size_t shift = pass * RADIX_BITS;
+
+        // count each digit, then turn the counts into where each digit starts
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (std::uint64_t key : sortKeys) {
+            ++offsets[(key >> shift) & (RADIX_BUCKETS - 1)];
+        }
+        std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), std::size_t(0));
+
+        // scatter in order so equal digits stay in the order they were in
+        for (std::size_t i = 0; i < sortKeys.size(); ++i) {
+            std::size_t to = offsets[(sortKeys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+            nextKeys[to] = sortKeys[i];
+            nextRows[to] = rows[i];
+        }
+        sortKeys.swap(nextKeys);
+        rows.swap(nextRows);
+    }
+
+    return rows;
+}
+
+std::vector<std::size_t> radix_sort::order_parallel(const std::vector<osp2023::time_type>& keys,
+    std::size_t numThreads)
+{
+    std::size_t numPasses = 0;
+    std::vector<std::uint64_t> sortKeys = offset_keys(keys, numPasses);
+    std::vector<std::size_t> rows(keys.size());
+    std::iota(rows.begin(), rows.end(), 0);
+    if (numPasses == 0) {
+        return rows;
+    }
+
+    std::vector<std::uint64_t> nextKeys(keys.size());
+    std::vector<std::size_t> nextRows(keys.size());
+
+    // each thread counts and scatters its own contiguous chunk
+    thread_pool pool(numThreads);
+    std::size_t numChunks = pool.size();
+    std::size_t chunkSize = (keys.size() + numChunks - 1) / numChunks;
+    std::vector<std::vector<std::size_t>> offsets(numChunks, std::vector<std::size_t>(RADIX_BUCKETS));
+
+    for (std::size_t pass = 0; pass < numPasses; ++pass) {
+        std::size_t shift = pass * RADIX_BITS;
+
+        for (std::size_t chunk = 0; chunk < numChunks; ++chunk) {
+            pool.submit([&, chunk] {
+                std::vector<std::size_t>& counts = offsets[chunk];
+                std::fill(counts.begin(), counts.end(), 0);
+                std::size_t end = std::min(keys.size(), (chunk + 1) * chunkSize);
+                for (std::size_t i = chunk * chunkSize; i < end; ++i) {
+                    ++counts[(sortKeys[i] >> shift) & (RADIX_BUCKETS - 1)];
+                }
+            });
+        }
+        pool.wait();
+
+        // a digit's rows go chunk by chunk, which keeps the sort stable
+        std::size_t start = 0;
+        for (std::size_t digit = 0; digit < RADIX_BUCKETS; ++digit) {
+            for (std::size_t chunk = 0; chunk < numChunks; ++chunk) {
+                std::size_t count = offsets[chunk][digit];
+                offsets[chunk][digit] = start;
+                start += count;
+            }
+        }
+
+        for (std::size_t chunk = 0; chunk < numChunks; ++chunk) {
+            pool.submit([&, chunk] {
+                std::vector<std::size_t>& starts = offsets[chunk];
+                std::size_t end = std::min(keys.size(), (chunk + 1) * chunkSize);
+                for (std::size_t i = chunk * chunkSize; i < end; ++i) {
+                    std::size_t to = starts[(sortKeys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+                    nextKeys[to] = sortKeys[i];
+                    nextRows[to] = rows[i];
+                }
+            });
+        }
+        pool.wait();
+
+        sortKeys.swap(nextKeys);
+        rows.swap(nextRows);
+    }
+
+    return rows;
+}
@@ -0,0 +1,40 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "types.h"
+
+// bits of the key looked at in each pass, 2^11 buckets covers every
+// burst time up to MAX_DURATION in a single counting pass
+#define RADIX_BITS 11
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+// below this many rows the threads cost more than they save
+#define PARALLEL_SORT_MIN_ROWS (1 << 20)
+
+/**
+ * a stable lsd radix sort of row numbers by an integer key.
+ * only as many passes as the largest key needs are made, so small bounded
+ * keys like burst times are a single O(n) counting sort.
+ **/
+class radix_sort
+{
+    private:
+        // the keys shifted so the smallest is 0, and how many passes they need
+        static std::vector<std::uint64_t> offset_keys(const std::vector<osp2023::time_type>& keys,
+            std::size_t& numPasses);
+    public:
+        // row numbers ordered by key, rows with the same key keep their order
+        // large inputs are sorted on every core
+        static std::vector<std::size_t> order(const std::vector<osp2023::time_type>& keys);
+
+        // the same order with one thread
+        static std::vector<std::size_t> order_serial(const std::vector<osp2023::time_type>& keys);
+
+        // the same order with numThreads threads (0 means one per core)
+        static std::vector<std::size_t> order_parallel(const std::vector<osp2023::time_type>& keys,
+            std::size_t numThreads = 0);
+};
+
+#endif
@@ -0,0 +1,98 @@
+#include "results_table.h"
+
+#include <string>
+#include <cstring>
+
+results_table::results_table(std::ostream& out, bool summaryOnly, bool showArrivals, 
+    bool showPercentiles):
+    out(out), summaryOnly(summaryOnly), showArrivals(showArrivals), 
+    showPercentiles(showPercentiles), writer(out)
+{
+    // get the length of table header
+    int divisions = NUM_TABLE_COL - 1 + (showArrivals ? 1 : 0);
+    processIdColLen = strlen(PROCESS_ID_HEADER);
+    burstTimeColLen = strlen(BURST_TIME_HEADER);
+    arrivalTimeColLen = showArrivals ? strlen(ARRIVAL_TIME_HEADER) : 0;
+    waitTimeColLen = strlen(WAIT_TIME_HEADER);
+    turnAroundTimeColLen = strlen(TURNAROUND_TIME_HEADER);
+    responseTimeColLen = strlen(RESPONSE_TIME_HEADER);
+
+    // calculate the length of a row
+    rowLen = processIdColLen + burstTimeColLen + arrivalTimeColLen + waitTimeColLen + 
+        turnAroundTimeColLen + responseTimeColLen + divisions;
+
+    if (summaryOnly) {
+        return;
+    }
+
+    // print out the header of the tables
+    std::string header = std::string() + 
+        PROCESS_ID_HEADER + TABLE_VERT_SEP +
+        BURST_TIME_HEADER + TABLE_VERT_SEP +
+        (showArrivals ? std::string(ARRIVAL_TIME_HEADER) + TABLE_VERT_SEP : "") +
+        WAIT_TIME_HEADER + TABLE_VERT_SEP +
+        TURNAROUND_TIME_HEADER + TABLE_VERT_SEP +
+        RESPONSE_TIME_HEADER + '\n';
+    writer.write(header.data(), header.length());
+
+    // print out the horizontal line below the header
+    writer.fill(TABLE_HORZ_SEP, rowLen);
+    writer.put('\n');
+}
+
+void results_table::finish()
+{
+    finish(summary);
+}
+
+void results_table::finish(const run_summary& totals)
+{
+    if (!summaryOnly) {
+        // print out message for no processes
+        if (summary.size() == 0) {
+            char padChar = ' ';
+            std::string noProcessesMsg = "NO PROCESSES ADDED :C";
+            std::size_t noProcessLeftPad = (rowLen - noProcessesMsg.length()) / 2;
+            writer.fill(padChar, noProcessLeftPad);
+            writer.write(noProcessesMsg.data(), noProcessesMsg.length());
+            writer.put('\n');
+        }
+
+        // the averages go after the table
+        writer.put('\n');
+        writer.flush();
+    }
+
+    // print out the average times
+    out << AVG_WAIT_TIME_TITLE << totals.getAvgWait() << '\n';
+    out << AVG_TURNAROUND_TIME_TITLE << totals.getAvgTurnaround() << '\n';
+    out << AVG_RESPONSE_TIME_TITLE << totals.getAvgResponse() << '\n';
+
+    // and how they are spread out
+    if (showPercentiles) {
+        print_percentiles(out, WAIT_TIME_PERCENTILES_TITLE, histograms.wait.report());
+        print_percentiles(out, TURNAROUND_TIME_PERCENTILES_TITLE, histograms.turnaround.report());
+        print_percentiles(out, RESPONSE_TIME_PERCENTILES_TITLE, histograms.response.report());
+    }
+    out.flush();
+}
+
+void results_table::print_percentiles(std::ostream& out, const char* title,
+    const latency_histogram::report_type& report)
+{
+    out << title;
+    for (std::size_t i = 0; i < latency_histogram::NUM_REPORTED; ++i) {
+        out << latency_histogram::REPORTED_NAMES[i] << " = " << report[i] << ", ";
+    }
+    out << "max = " << report[latency_histogram::NUM_REPORTED] << '\n';
+}
+
+const run_summary& results_table::getSummary() const
+{
+    return summary;
+}
+
+const latency_histograms& results_table::getHistograms() const
+{
+    return histograms;
+}
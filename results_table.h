@@ -0,0 +1,104 @@
+#ifndef RESULTS_TABLE_H
+#define RESULTS_TABLE_H
+
+#include <ostream>
+#include <cstddef>
+#include "types.h"
+#include "buffered_writer.h"
+#include "run_summary.h"
+#include "latency_histogram.h"
+
+#define TABLE_VERT_SEP '|'
+#define TABLE_HORZ_SEP '-'
+
+#define PROCESS_ID_HEADER " Process ID "
+#define BURST_TIME_HEADER " Burst Time "
+#define ARRIVAL_TIME_HEADER " Arrival Time "
+#define WAIT_TIME_HEADER " Wait Time "
+#define TURNAROUND_TIME_HEADER " Turnaround Time "
+#define RESPONSE_TIME_HEADER " Response Time "
+#define NUM_TABLE_COL 5
+
+#define AVG_WAIT_TIME_TITLE "Avg. waiting time = "
+#define AVG_TURNAROUND_TIME_TITLE "Avg. turnaround time = "
+#define AVG_RESPONSE_TIME_TITLE "Avg. response time = " 
+
+#define WAIT_TIME_PERCENTILES_TITLE "Waiting time percentiles : "
+#define TURNAROUND_TIME_PERCENTILES_TITLE "Turnaround time percentiles : "
+#define RESPONSE_TIME_PERCENTILES_TITLE "Response time percentiles : "
+
+/**
+ * prints the per process results table a row at a time and adds up the
+ * averages that go under it. the rows don't have to be in memory together,
+ * so a trace can be printed as it is simulated.
+ **/
+class results_table
+{
+    private:
+        std::ostream& out;
+        bool summaryOnly;
+        bool showArrivals;
+        bool showPercentiles;
+        buffered_writer writer;
+        run_summary summary;
+        latency_histograms histograms;
+
+        // the width of each column, and the whole row with its separators
+        std::size_t processIdColLen;
+        std::size_t burstTimeColLen;
+        std::size_t arrivalTimeColLen;
+        std::size_t waitTimeColLen;
+        std::size_t turnAroundTimeColLen;
+        std::size_t responseTimeColLen;
+        std::size_t rowLen;
+    public:
+        // prints the header straight away, unless only the averages are wanted
+        // the arrival times only get a column if showArrivals, and the percentiles
+        // of the times are only worked out and printed if showPercentiles
+        results_table(std::ostream& out, bool summaryOnly, bool showArrivals, 
+            bool showPercentiles = false);
+
+        // print one process (unless summary only) and count it in the averages
+        // the percentiles are counted here too, the scheduling loops don't know about them
+        void add(osp2023::id_type id, osp2023::time_type burstTime, osp2023::time_type arrivalTime,
+            osp2023::time_type waitTime, osp2023::time_type turnaroundTime, osp2023::time_type responseTime)
+        {
+            summary.add(waitTime, turnaroundTime, responseTime);
+            if (showPercentiles) {
+                histograms.add(waitTime, turnaroundTime, responseTime);
+            }
+            if (summaryOnly) {
+                return;
+            }
+
+            writer.write_left(id, processIdColLen);
+            writer.put(TABLE_VERT_SEP);
+            writer.write_left(burstTime, burstTimeColLen);
+            writer.put(TABLE_VERT_SEP);
+            if (showArrivals) {
+                writer.write_left(arrivalTime, arrivalTimeColLen);
+                writer.put(TABLE_VERT_SEP);
+            }
+            writer.write_left(waitTime, waitTimeColLen);
+            writer.put(TABLE_VERT_SEP);
+            writer.write_left(turnaroundTime, turnAroundTimeColLen);
+            writer.put(TABLE_VERT_SEP);
+            writer.write_left(responseTime, responseTimeColLen);
+            writer.put('\n');
+        }
+
+        // end the table and print the averages, then the percentiles if they are wanted
+        void finish();
+        // the same, but the averages are of totals instead of the rows printed,
+        // for when only some of the processes are printed
+        void finish(const run_summary& totals);
+
+        const run_summary& getSummary() const;
+        const latency_histograms& getHistograms() const;
+
+        // print the reported percentiles and max of one of the times on a line
+        static void print_percentiles(std::ostream& out, const char* title,
+            const latency_histogram::report_type& report);
+};
+
+#endif
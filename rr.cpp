@@ -1,28 +1,80 @@
 #include <iostream>
 #include <vector>
+#include <optional>
 #include <queue>
 
 #include "loader.h"
 #include "pcb.h"
+#include "process_table.h"
 #include "types.h"
 #include "simulator.h"
+#include "cmd_options.h"
+#include "stats_recorder.h"
 
-#define QUANTUM_INDEX 1
-#define FILE_NAME_INDEX 2
-#define NUM_CMD_ARGS 3
+// positions of the plain args, not counting the program name or options
+#define QUANTUM_INDEX 0
+#define FILE_NAME_INDEX 1
+#define NUM_CMD_ARGS 2
+
+// in sweep mode only the file name is given
+#define SWEEP_FILE_NAME_INDEX 0
+#define NUM_SWEEP_CMD_ARGS 1
+
+#define SUMMARY_ONLY_OPTION "--summary-only"
+#define PERCENTILES_OPTION "--percentiles"
+#define CPUS_OPTION "--cpus"
+#define TIMELINE_OPTION "--timeline"
+#define STATS_OPTION "--stats"
+#define SWEEP_OPTION "--sweep"
 
 int main(int argc, char** argv)
 {
+    // split the options from the plain args
+    // if there is an unknown option exit the program
+    cmd_options cmd({SUMMARY_ONLY_OPTION, PERCENTILES_OPTION, SWEEP_OPTION, STATS_OPTION}, {CPUS_OPTION, TIMELINE_OPTION});
+    try {
+        cmd.parse(argc, argv);
+    } catch (const std::runtime_error& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // a sweep tries every quantum instead of taking one
+    bool sweep = cmd.has(SWEEP_OPTION);
+
     // check if the number of cmd arguments is correct
     // if it doesn't exit the program
-    if (argc != NUM_CMD_ARGS) {
-        std::string error = "ERROR : incorrect numnber of args : should be ./rr <quantum> <datafile>";
+    if (cmd.positional().size() != (sweep ? NUM_SWEEP_CMD_ARGS : NUM_CMD_ARGS)) {
+        std::string error = "ERROR : incorrect numnber of args : should be ./rr [--summary-only] [--percentiles] [--cpus <n> | --timeline <file> | --stats] <quantum> <datafile>"
+            " or ./rr [--summary-only] [--percentiles] --sweep <datafile>";
         std::cout << error << std::endl;
         return EXIT_FAILURE;
     }
 
+    // set up how the results are printed
+    sim_options options;
+    options.summary_only = cmd.has(SUMMARY_ONLY_OPTION);
+    options.percentiles = cmd.has(PERCENTILES_OPTION);
+
+    if (sweep) {
+        // load the file once for every quantum
+        process_table processes;
+        try{
+            processes = loader::load(cmd.positional().at(SWEEP_FILE_NAME_INDEX));
+        } catch(const std::exception& e) {
+            std::cout << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // simulate every quantum concurrently
+        std::vector<sweep_result> results = 
+            simulator::sweep_rr(processes, pcb::MIN_DURATION, pcb::MAX_DURATION, options.percentiles);
+        simulator::print_sweep(results, options);
+        return EXIT_SUCCESS;
+    }
+
     // get the quantum string from cmd args
-    std::string quantumStr = argv[QUANTUM_INDEX];
+    std::string quantumStr = cmd.positional().at(QUANTUM_INDEX);
 
     // try to parse the quantum string
     osp2023::time_type quantum = osp2023::time_not_set;
@@ -43,20 +95,90 @@ int main(int argc, char** argv)
         return EXIT_FAILURE;
     }
 
+    // try to parse the number of cpus, one unless asked for more
+    std::size_t numCpus = 1;
+    if (cmd.has(CPUS_OPTION)) {
+        long long cpusArg = 0;
+        try {
+            cpusArg = std::stoll(cmd.value(CPUS_OPTION));
+        } catch (const std::exception& e) {
+            std::string error = "ERROR : unable to parse cpus cmd arg";
+            std::cout << error << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (cpusArg < 1) {
+            std::string error = "ERROR : cpus must be at least 1";
+            std::cout << error << std::endl;
+            return EXIT_FAILURE;
+        }
+        numCpus = static_cast<std::size_t>(cpusArg);
+    }
+
+    // only one of the ways of running can be picked
+    if (cmd.has(CPUS_OPTION) + cmd.has(TIMELINE_OPTION) + cmd.has(STATS_OPTION) > 1) {
+        std::string error = "ERROR : only one of --cpus, --timeline and --stats can be used";
+        std::cout << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
     // get the file name from cmd args
-    std::string fileName = argv[FILE_NAME_INDEX];
+    std::string fileName = cmd.positional().at(FILE_NAME_INDEX);
 
-    //try to load the processes CSV file
-    std::vector<pcb> processes;
+    //try to load the processes CSV file or binary trace
+    // the stats time everything from the load onwards
+    std::optional<stats_recorder> stats;
+    if (cmd.has(STATS_OPTION)) {
+        stats.emplace();
+        stats->begin_phase(STATS_PHASE_LOAD);
+    }
+
+    process_table processes;
     try{
-        processes = loader::load_csv(fileName);
-    } catch(const std::runtime_error& e) {
+        processes = loader::load(fileName);
+    } catch(const std::exception& e) {
         std::cout << e.what() << std::endl;
         return EXIT_FAILURE;
     }
 
     //start the simulation
-    simulator::run_rr(quantum, processes);
+    // the event core handles processes that don't all arrive at 0
+    // more than one cpu gives each its own run queue
+    if (cmd.has(CPUS_OPTION)) {
+        simulator::run_multi(event_policy::RR, quantum, numCpus, processes, options);
+    } else if (cmd.has(TIMELINE_OPTION)) {
+        // record every slice handed out and save it when the run is done
+        timeline_recorder timeline;
+        // the queue version goes in arrival order when processes arrive late
+        if (processes.hasArrivalTimes()) {
+            simulator::run(rr_queue_policy(quantum), processes, options, timeline);
+        } else {
+            simulator::run(rr_policy(quantum), processes, options, timeline);
+        }
+        try {
+            timeline.save(cmd.value(TIMELINE_OPTION));
+        } catch (const std::runtime_error& e) {
+            std::cout << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    } else if (stats) {
+        // timed on the same path as a plain run, the event core when processes
+        // arrive late, and counted with the same policy as the timeline
+        if (processes.hasArrivalTimes()) {
+            simulator::run_stats(rr_queue_policy(quantum), processes, options, *stats,
+                [&stats, quantum](process_table& table) {
+                    stats->begin_phase(STATS_PHASE_SCHEDULE);
+                    simulator::schedule_events(event_policy::RR, quantum, table);
+                });
+        } else {
+            simulator::run_stats(rr_policy(quantum), rr_policy(quantum), processes, options, *stats);
+        }
+        // the stats go to stderr so the results on stdout stay the same
+        stats->write_json(std::cerr, "rr", quantum, processes.size());
+    } else if (processes.hasArrivalTimes()) {
+        simulator::run_rr_events(quantum, processes, options);
+    } else {
+        simulator::run_rr(quantum, processes, options);
+    }
 
     //exit main
     return EXIT_SUCCESS;
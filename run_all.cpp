@@ -1,27 +1,46 @@
 #include <iostream>
 #include <vector>
+#include <sstream>
+#include <functional>
 
 #include "loader.h"
 #include "pcb.h"
+#include "process_table.h"
 #include "types.h"
 #include "simulator.h"
+#include "cmd_options.h"
+#include "thread_pool.h"
 
-#define QUANTUM_INDEX 1
-#define FILE_NAME_INDEX 2
-#define NUM_CMD_ARGS 3
+// positions of the plain args, not counting the program name or options
+#define QUANTUM_INDEX 0
+#define FILE_NAME_INDEX 1
+#define NUM_CMD_ARGS 2
+
+#define SUMMARY_ONLY_OPTION "--summary-only"
+#define PERCENTILES_OPTION "--percentiles"
 
 int main(int argc, char** argv)
 {
+    // split the options from the plain args
+    // if there is an unknown option exit the program
+    cmd_options cmd({SUMMARY_ONLY_OPTION, PERCENTILES_OPTION});
+    try {
+        cmd.parse(argc, argv);
+    } catch (const std::runtime_error& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
     // check if the number of cmd arguments is correct
     // if it doesn't exit the program
-    if (argc != NUM_CMD_ARGS) {
-        std::string error = "ERROR : incorrect numnber of args : should be ./rr <quantum> <datafile>";
+    if (cmd.positional().size() != NUM_CMD_ARGS) {
+        std::string error = "ERROR : incorrect numnber of args : should be ./run_all [--summary-only] [--percentiles] <quantum> <datafile>";
         std::cout << error << std::endl;
         return EXIT_FAILURE;
     }
 
     // get the quantum string from cmd args
-    std::string quantumStr = argv[QUANTUM_INDEX];
+    std::string quantumStr = cmd.positional().at(QUANTUM_INDEX);
 
     // try to parse the quantum string
     osp2023::time_type quantum = osp2023::time_not_set;
@@ -43,40 +62,86 @@ int main(int argc, char** argv)
     }
 
     // get the file name from cmd args
-    std::string fileName = argv[FILE_NAME_INDEX];
+    std::string fileName = cmd.positional().at(FILE_NAME_INDEX);
 
-    //try to load the processes CSV file
-    std::vector<pcb> processes;
+    //try to load the processes CSV file or binary trace
+    process_table processes;
     try{
-        processes = loader::load_csv(fileName);
+        processes = loader::load(fileName);
     } catch(const std::exception& e) {
         std::cout << e.what() << std::endl;
         return EXIT_FAILURE;
     }
 
-    std::cout << " ----==== FIFO ====----" << std::endl;
-    simulator::run_fifo(processes);
-    std::cout << std::endl;
+    // every policy runs on its own copy of the processes
+    // so they can all run at the same time
+    // the title goes before the results of each one
+    std::vector<std::pair<std::string, std::function<void(const sim_options&)>>> policies = {
+        {" ----==== FIFO ====----", 
+            [&](const sim_options& options) { simulator::run_fifo(processes, options); }},
+        {"----==== FIFO QUEUE ====----", 
+            [&](const sim_options& options) { simulator::run_fifo_queue(processes, options); }},
+        {"----==== SJF ====----", 
+            [&](const sim_options& options) { simulator::run_sjf(processes, options); }},
+        {"----==== SJF QUEUE ====----", 
+            [&](const sim_options& options) { simulator::run_sjf_queue(processes, options); }},
+        {"----==== RR ====----", 
+            [&](const sim_options& options) { simulator::run_rr(quantum, processes, options); }},
+        {"----==== RR QUEUE ====----", 
+            [&](const sim_options& options) { simulator::run_rr_queue(quantum, processes, options); }},
+    };
 
-    std::cout << "----==== FIFO QUEUE ====----" << std::endl;
-    simulator::run_fifo_queue(processes);
-    std::cout << std::endl;
+    // every other policy goes through simulate, which lets processes in as they arrive
+    // but rr rounds works out whole rounds in closed form and only
+    // holds when every process is there from the start
+    if (!processes.hasArrivalTimes()) {
+        policies.push_back({"----==== RR ROUNDS ====----",
+            [&](const sim_options& options) { simulator::run_rr_rounds(quantum, processes, options); }});
+    }
 
-    std::cout << "----==== SJF ====----" << std::endl;
-    simulator::run_sjf(processes);
-    std::cout << std::endl;
+    policies.insert(policies.end(), {
+        {"----==== SRTF ====----", 
+            [&](const sim_options& options) { simulator::run_srtf(processes, options); }},
+        {"----==== MLFQ ====----", 
+            [&](const sim_options& options) { 
+                simulator::run_mlfq(quantum, MLFQ_DEFAULT_LEVELS, MLFQ_DEFAULT_BOOST, processes, options); }},
+        {"----==== CFS ====----", 
+            [&](const sim_options& options) { 
+                simulator::run_cfs(CFS_DEFAULT_TARGET_LATENCY, CFS_DEFAULT_MIN_GRANULARITY, processes, options); }},
+        {"----==== LOTTERY ====----", 
+            [&](const sim_options& options) { 
+                simulator::run_lottery(quantum, LOTTERY_DEFAULT_SEED, processes, options); }},
+        {"----==== STRIDE ====----", 
+            [&](const sim_options& options) { simulator::run_stride(quantum, processes, options); }},
+    });
 
-    std::cout << "----==== SJF QUEUE ====----" << std::endl;
-    simulator::run_sjf_queue(processes);
-    std::cout << std::endl;
+    // each policy prints into its own buffer so the output doesn't interleave
+    std::vector<std::ostringstream> outputs(policies.size());
+    try {
+        thread_pool pool(policies.size());
+        for (std::size_t i = 0; i < policies.size(); ++i) {
+            pool.submit([&policies, &outputs, &cmd, i] {
+                // set up how the results are printed
+                sim_options options;
+                options.out = &outputs[i];
+                options.summary_only = cmd.has(SUMMARY_ONLY_OPTION);
+                options.percentiles = cmd.has(PERCENTILES_OPTION);
 
-    std::cout << "----==== RR ====----" << std::endl;
-    simulator::run_rr(quantum, processes);
-    std::cout << std::endl;
+                policies[i].second(options);
+            });
+        }
+        pool.wait();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
 
-    std::cout << "----==== RR QUEUE ====----" << std::endl;
-    simulator::run_rr_queue(quantum, processes);
-    std::cout << std::endl;
+    // print the results in the same order every time
+    for (std::size_t i = 0; i < policies.size(); ++i) {
+        std::cout << policies[i].first << '\n';
+        std::cout << outputs[i].str() << '\n';
+    }
+    std::cout.flush();
 
     //exit main
     return EXIT_SUCCESS;
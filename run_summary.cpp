@@ -0,0 +1,57 @@
+#include "run_summary.h"
+
+run_summary::run_summary():
+    numProcesses(0),
+    totalWait(osp2023::time_zero),
+    totalTurnaround(osp2023::time_zero),
+    totalResponse(osp2023::time_zero) {};
+
+run_summary::run_summary(std::size_t numProcesses, osp2023::time_type totalWait,
+    osp2023::time_type totalTurnaround, osp2023::time_type totalResponse):
+    numProcesses(numProcesses),
+    totalWait(totalWait),
+    totalTurnaround(totalTurnaround),
+    totalResponse(totalResponse) {};
+
+void run_summary::merge(const run_summary& other)
+{
+    numProcesses += other.numProcesses;
+    totalWait += other.totalWait;
+    totalTurnaround += other.totalTurnaround;
+    totalResponse += other.totalResponse;
+}
+
+std::size_t run_summary::size() const
+{
+    return numProcesses;
+}
+
+osp2023::time_type run_summary::getTotalWait() const
+{
+    return totalWait;
+}
+
+osp2023::time_type run_summary::getTotalTurnaround() const
+{
+    return totalTurnaround;
+}
+
+osp2023::time_type run_summary::getTotalResponse() const
+{
+    return totalResponse;
+}
+
+double run_summary::getAvgWait() const
+{
+    return (numProcesses == 0) ? 0.0 : totalWait / (double)numProcesses;
+}
+
+double run_summary::getAvgTurnaround() const
+{
+    return (numProcesses == 0) ? 0.0 : totalTurnaround / (double)numProcesses;
+}
+
+double run_summary::getAvgResponse() const
+{
+    return (numProcesses == 0) ? 0.0 : totalResponse / (double)numProcesses;
+}
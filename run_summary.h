@@ -0,0 +1,47 @@
+#ifndef RUN_SUMMARY_H
+#define RUN_SUMMARY_H
+
+#include <cstddef>
+#include "types.h"
+
+/**
+ * running totals of the wait, turnaround and response times of a simulation.
+ * summaries of different parts of a run can be merged together.
+ **/
+class run_summary
+{
+    private:
+        std::size_t numProcesses;
+        osp2023::time_type totalWait;
+        osp2023::time_type totalTurnaround;
+        osp2023::time_type totalResponse;
+    public:
+        run_summary();
+        // pick up the totals of an earlier run
+        run_summary(std::size_t numProcesses, osp2023::time_type totalWait,
+            osp2023::time_type totalTurnaround, osp2023::time_type totalResponse);
+
+        // count one process, this is called once per process in hot loops so it's inline
+        void add(osp2023::time_type wait, osp2023::time_type turnaround, osp2023::time_type response)
+        {
+            ++numProcesses;
+            totalWait += wait;
+            totalTurnaround += turnaround;
+            totalResponse += response;
+        }
+
+        // add the totals of another summary to this one
+        void merge(const run_summary& other);
+
+        std::size_t size() const;
+        osp2023::time_type getTotalWait() const;
+        osp2023::time_type getTotalTurnaround() const;
+        osp2023::time_type getTotalResponse() const;
+
+        // the averages are 0 when there are no processes
+        double getAvgWait() const;
+        double getAvgTurnaround() const;
+        double getAvgResponse() const;
+};
+
+#endif
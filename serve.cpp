@@ -0,0 +1,88 @@
+#include <iostream>
+#include <string>
+
+#include "sim_server.h"
+#include "trace_cache.h"
+#include "cmd_options.h"
+
+// there are no plain args, everything comes in the requests
+#define NUM_CMD_ARGS 0
+
+#define SOCKET_OPTION "--socket"
+#define THREADS_OPTION "--threads"
+#define MAX_TRACES_OPTION "--max-traces"
+
+int main(int argc, char** argv)
+{
+    // split the options from the plain args
+    // if there is an unknown option exit the program
+    cmd_options cmd({}, {SOCKET_OPTION, THREADS_OPTION, MAX_TRACES_OPTION});
+    try {
+        cmd.parse(argc, argv);
+    } catch (const std::runtime_error& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // check if the number of cmd arguments is correct
+    // if it doesn't exit the program
+    if (cmd.positional().size() != NUM_CMD_ARGS) {
+        std::string error = "ERROR : incorrect numnber of args : should be ./serve [--socket <path>] [--threads <n>] [--max-traces <n>]";
+        std::cout << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // try to parse the number of threads, one per core unless asked for fewer
+    std::size_t numThreads = 0;
+    if (cmd.has(THREADS_OPTION)) {
+        long long threadsArg = 0;
+        try {
+            threadsArg = std::stoll(cmd.value(THREADS_OPTION));
+        } catch (const std::exception& e) {
+            std::string error = "ERROR : unable to parse threads cmd arg";
+            std::cout << error << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (threadsArg < 1) {
+            std::string error = "ERROR : threads must be at least 1";
+            std::cout << error << std::endl;
+            return EXIT_FAILURE;
+        }
+        numThreads = static_cast<std::size_t>(threadsArg);
+    }
+
+    // try to parse how many traces to keep loaded
+    std::size_t maxTraces = TRACE_CACHE_DEFAULT_SIZE;
+    if (cmd.has(MAX_TRACES_OPTION)) {
+        long long maxTracesArg = 0;
+        try {
+            maxTracesArg = std::stoll(cmd.value(MAX_TRACES_OPTION));
+        } catch (const std::exception& e) {
+            std::string error = "ERROR : unable to parse max traces cmd arg";
+            std::cout << error << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (maxTracesArg < 1) {
+            std::string error = "ERROR : max traces must be at least 1";
+            std::cout << error << std::endl;
+            return EXIT_FAILURE;
+        }
+        maxTraces = static_cast<std::size_t>(maxTracesArg);
+    }
+
+    // answer requests from stdin until it closes, or from a socket for good
+    sim_server server(numThreads, maxTraces);
+    try {
+        if (cmd.has(SOCKET_OPTION)) {
+            server.serve_socket(cmd.value(SOCKET_OPTION));
+        } else {
+            server.serve_stream(std::cin, std::cout);
+        }
+    } catch (const std::runtime_error& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    //exit main
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,31 @@
+#include "share_policies.h"
+
+lottery_policy::lottery_policy(osp2023::time_type quantum, std::uint64_t seed):
+    quantum(quantum), seed(seed), rng(seed), readyTickets(0) {};
+
+void lottery_policy::prepare(process_table& processes)
+{
+    tickets = processes.getWeights().data();
+    readyTickets = fenwick_tree(processes.size());
+    totalTickets = 0;
+    numReady = 0;
+    isRunning = false;
+    // start the draws again, so preparing twice gives the same schedule twice
+    rng.seed(seed);
+}
+
+stride_policy::stride_policy(osp2023::time_type quantum): quantum(quantum) {};
+
+void stride_policy::prepare(process_table& processes)
+{
+    // a process with more tickets than STRIDE_ONE still has to move forward
+    const std::vector<osp2023::weight_type>& tickets = processes.getWeights();
+    strides.resize(processes.size());
+    for (std::size_t i = 0; i < processes.size(); ++i) {
+        strides[i] = std::max<osp2023::time_type>(1, STRIDE_ONE / tickets[i]);
+    }
+    passes.assign(processes.size(), 0);
+    hasRun.assign(processes.size(), false);
+    readyRows = {};
+    globalPass = 0;
+}
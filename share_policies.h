@@ -0,0 +1,148 @@
+#ifndef SHARE_POLICIES_H
+#define SHARE_POLICIES_H
+
+#include <vector>
+#include <queue>
+#include <random>
+#include <functional>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include "types.h"
+#include "process_table.h"
+#include "fenwick_tree.h"
+
+#define LOTTERY_DEFAULT_SEED 2023
+// a process with one ticket moves its pass on this much each quantum
+#define STRIDE_ONE (1 << 20)
+
+/**
+ * proportional share policies for simulate<Policy>, a process gets the cpu
+ * in proportion to its tickets. the tickets are the weight column of the
+ * table, so every process has the same share unless the trace gives weights.
+ * both run a process for up to a quantum at a time like rr.
+ **/
+
+// lottery scheduling, every quantum a ticket is drawn from the ready processes
+// and its owner runs. the tickets live in a fenwick tree over the rows so a draw
+// is O(log n) instead of a walk over every process. the draws come from a seeded
+// mt19937_64, so the same seed always gives the same schedule.
+// the row picked by next() keeps its tickets in the tree while it runs, most
+// rows are ready again straight after so that saves two walks of the tree
+// every quantum. a row that isn't ready again before the next draw has
+// finished, so that's when its tickets come out.
+class lottery_policy
+{
+    private:
+        osp2023::time_type quantum;
+        std::uint64_t seed;
+        std::mt19937_64 rng;
+
+        const osp2023::weight_type* tickets = nullptr;
+        // the tickets of every ready row, 0 for the rest
+        // the loader keeps every weight at most MAX_WEIGHT, so the total can't overflow
+        fenwick_tree readyTickets;
+        osp2023::weight_type totalTickets = 0;
+        std::size_t numReady = 0;
+        // the row that is running, its tickets are still in the tree
+        std::size_t runningRow = 0;
+        bool isRunning = false;
+    public:
+        lottery_policy(osp2023::time_type quantum, std::uint64_t seed = LOTTERY_DEFAULT_SEED);
+        void prepare(process_table& processes);
+
+        void ready(std::size_t row)
+        {
+            // the running row used its quantum, its tickets never left
+            if (isRunning && row == runningRow) {
+                isRunning = false;
+                return;
+            }
+            readyTickets.add(row, tickets[row]);
+            totalTickets += tickets[row];
+            ++numReady;
+        }
+
+        bool empty() const
+        {
+            return numReady == (isRunning ? 1 : 0);
+        }
+
+        std::size_t next()
+        {
+            // the last row to run wasn't ready again, so it has finished
+            if (isRunning) {
+                readyTickets.add(runningRow, -tickets[runningRow]);
+                totalTickets -= tickets[runningRow];
+                --numReady;
+            }
+
+            // draw a ticket and find whose it is, every ticket is as likely as any
+            // other which rng() % totalTickets wouldn't quite give
+            std::uniform_int_distribution<std::uint64_t> draw(0, static_cast<std::uint64_t>(totalTickets) - 1);
+            osp2023::weight_type ticket = static_cast<osp2023::weight_type>(draw(rng));
+            runningRow = readyTickets.find(ticket);
+            isRunning = true;
+            return runningRow;
+        }
+
+        osp2023::time_type slice(std::size_t, osp2023::time_type remaining) const
+        {
+            return std::min(quantum, remaining);
+        }
+};
+
+// stride scheduling, the deterministic version of lottery. each process has a
+// stride of STRIDE_ONE over its tickets and a pass that goes up by its stride
+// every time it runs, the ready process with the lowest pass runs next. the
+// ready set is a min-heap on (pass, row) so ties go to table order. a row that
+// just ran has one of the highest passes, so pushing it back hardly moves it.
+class stride_policy
+{
+    private:
+        osp2023::time_type quantum;
+
+        std::vector<osp2023::time_type> strides;
+        std::vector<osp2023::time_type> passes;
+        std::vector<char> hasRun;
+        std::priority_queue<std::pair<osp2023::time_type, std::size_t>,
+            std::vector<std::pair<osp2023::time_type, std::size_t>>,
+            std::greater<std::pair<osp2023::time_type, std::size_t>>> readyRows;
+        // the pass of the last process picked, new processes start from here
+        // so they don't get the cpu to themselves until they catch up
+        osp2023::time_type globalPass = 0;
+    public:
+        explicit stride_policy(osp2023::time_type quantum);
+        void prepare(process_table& processes);
+
+        void ready(std::size_t row)
+        {
+            if (!hasRun[row]) {
+                hasRun[row] = true;
+                passes[row] = globalPass;
+            }
+            readyRows.push({passes[row], row});
+        }
+
+        bool empty() const
+        {
+            return readyRows.empty();
+        }
+
+        std::size_t next()
+        {
+            std::size_t row = readyRows.top().second;
+            globalPass = readyRows.top().first;
+            readyRows.pop();
+            return row;
+        }
+
+        osp2023::time_type slice(std::size_t row, osp2023::time_type remaining)
+        {
+            passes[row] += strides[row];
+            return std::min(quantum, remaining);
+        }
+};
+
+#endif
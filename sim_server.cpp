@@ -0,0 +1,304 @@
+#include "sim_server.h"
+#include "simulator.h"
+#include "json.h"
+
+#include <sstream>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <charconv>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+sim_server::sim_server(std::size_t numThreads, std::size_t maxTraces):
+    traces(maxTraces), pool(numThreads) {};
+
+long long sim_server::parse_number(const std::string& name, const std::string& value)
+{
+    long long number = 0;
+    const char* last = value.data() + value.size();
+    std::from_chars_result result = std::from_chars(value.data(), last, number);
+    if (value.empty() || result.ec != std::errc() || result.ptr != last || number < 0) {
+        throw std::runtime_error("ERROR : server : unable to parse " + name);
+    }
+    return number;
+}
+
+void sim_server::parse_request(const std::string& line, sim_request& request)
+{
+    std::istringstream fields(line);
+    std::string field;
+    while (fields >> field) {
+        std::size_t sep = field.find(REQUEST_VALUE_SEP);
+        if (sep == std::string::npos) {
+            throw std::runtime_error("ERROR : server : field \"" + field + "\" should be name=value");
+        }
+        std::string name = field.substr(0, sep);
+        std::string value = field.substr(sep + 1);
+
+        if (name == "id") {
+            request.id = value;
+        } else if (name == "policy") {
+            request.policy = value;
+        } else if (name == "trace") {
+            request.trace = value;
+        } else if (name == "quantum") {
+            request.quantum = parse_number(name, value);
+        } else if (name == "levels") {
+            request.levels = parse_number(name, value);
+        } else if (name == "boost") {
+            request.boost = parse_number(name, value);
+        } else if (name == "latency") {
+            request.latency = parse_number(name, value);
+        } else if (name == "granularity") {
+            request.granularity = parse_number(name, value);
+        } else if (name == "seed") {
+            request.seed = parse_number(name, value);
+        } else if (name == "rows") {
+            request.rows = parse_number(name, value) != 0;
+        } else {
+            throw std::runtime_error("ERROR : server : unknown field \"" + name + "\"");
+        }
+    }
+
+    if (request.policy.empty()) {
+        throw std::runtime_error("ERROR : server : request has no policy");
+    }
+    if (request.trace.empty()) {
+        throw std::runtime_error("ERROR : server : request has no trace");
+    }
+
+    // the time sliced policies need a quantum in the same range as the programs take
+    bool needsQuantum = request.policy == "rr" || request.policy == "mlfq" ||
+        request.policy == "lottery" || request.policy == "stride";
+    if (needsQuantum && (request.quantum < pcb::MIN_DURATION || request.quantum > pcb::MAX_DURATION)) {
+        throw std::runtime_error("ERROR : server : " + request.policy + " quantum must be between " +
+            std::to_string(pcb::MIN_DURATION) + " and " + std::to_string(pcb::MAX_DURATION));
+    }
+}
+
+process_table sim_server::simulate(const sim_request& request, const process_table& processes)
+{
+    // the cached table is shared between requests, so each one runs on its own copy
+    process_table copy = processes;
+
+    // the same choices the programs make, the event core handles arrival times
+    if (request.policy == "fifo") {
+        if (copy.hasArrivalTimes()) {
+            simulator::schedule_events(event_policy::FIFO, osp2023::time_zero, copy);
+        } else {
+            simulator::schedule_fifo(copy);
+        }
+    } else if (request.policy == "sjf") {
+        if (copy.hasArrivalTimes()) {
+            simulator::schedule_events(event_policy::SJF, osp2023::time_zero, copy);
+        } else {
+            simulator::schedule_sjf(copy);
+        }
+    } else if (request.policy == "rr") {
+        if (copy.hasArrivalTimes()) {
+            simulator::schedule_events(event_policy::RR, request.quantum, copy);
+        } else {
+            simulator::schedule_rr(request.quantum, copy);
+        }
+    } else if (request.policy == "srtf") {
+        simulator::schedule_srtf(copy);
+    } else if (request.policy == "mlfq") {
+        simulator::schedule_mlfq(request.quantum, request.levels, request.boost, copy);
+    } else if (request.policy == "cfs") {
+        simulator::schedule_cfs(request.latency, request.granularity, copy);
+    } else if (request.policy == "lottery") {
+        simulator::schedule_lottery(request.quantum, request.seed, copy);
+    } else if (request.policy == "stride") {
+        simulator::schedule_stride(request.quantum, copy);
+    } else {
+        throw std::runtime_error("ERROR : server : unknown policy \"" + request.policy + "\"");
+    }
+    return copy;
+}
+
+std::string sim_server::json_percentiles(const latency_histogram& histogram)
+{
+    std::string object = "{";
+    for (std::size_t i = 0; i < latency_histogram::NUM_REPORTED; ++i) {
+        object += json::quote(latency_histogram::REPORTED_NAMES[i]) + ":" + 
+            std::to_string(histogram.percentile(latency_histogram::REPORTED_PERCENTILES[i])) + ",";
+    }
+    return object + "\"max\":" + std::to_string(histogram.max()) + "}";
+}
+
+std::string sim_server::answer(const std::string& line, std::size_t requestNumber)
+{
+    std::ostringstream out;
+    out << "{\"request\":" << requestNumber;
+
+    // the id goes in as soon as it is known, an answer to a request that
+    // doesn't parse can only be matched up by its request number
+    sim_request request;
+    try {
+        parse_request(line, request);
+        out << ",\"id\":" << json::quote(request.id);
+
+        bool cached = false;
+        std::shared_ptr<const process_table> processes = traces.get(request.trace, cached);
+        process_table results = simulate(request, *processes);
+        run_summary summary = simulator::summarise(results);
+
+        out << ",\"policy\":" << json::quote(request.policy);
+        out << ",\"trace\":" << json::quote(request.trace);
+        out << ",\"cached\":" << (cached ? "true" : "false");
+        out << ",\"processes\":" << summary.size();
+        out << ",\"total_wait\":" << summary.getTotalWait();
+        out << ",\"total_turnaround\":" << summary.getTotalTurnaround();
+        out << ",\"total_response\":" << summary.getTotalResponse();
+        out << ",\"avg_wait\":" << summary.getAvgWait();
+        out << ",\"avg_turnaround\":" << summary.getAvgTurnaround();
+        out << ",\"avg_response\":" << summary.getAvgResponse();
+
+        // how the times are spread out, eg. "wait":{"p50":10,...,"max":40}
+        latency_histograms histograms = simulator::latencies(results);
+        out << ",\"percentiles\":{";
+        out << "\"wait\":" << json_percentiles(histograms.wait);
+        out << ",\"turnaround\":" << json_percentiles(histograms.turnaround);
+        out << ",\"response\":" << json_percentiles(histograms.response);
+        out << "}";
+
+        // in the order the programs print them
+        if (request.rows) {
+            out << ",\"rows\":[";
+            for (std::size_t i = 0; i < results.size(); ++i) {
+                out << (i == 0 ? "[" : ",[") << results.getIds()[i];
+                out << "," << results.getBurstTimes()[i];
+                out << "," << results.getArrivalTimes()[i];
+                out << "," << results.getWaitTimes()[i];
+                out << "," << results.getTurnaroundTimes()[i];
+                out << "," << results.getResponseTimes()[i] << "]";
+            }
+            out << "]";
+        }
+    } catch (const std::exception& e) {
+        // start again so a half written answer isn't sent
+        out.str("");
+        out << "{\"request\":" << requestNumber;
+        out << ",\"id\":" << json::quote(request.id);
+        out << ",\"error\":" << json::quote(e.what());
+    }
+    out << "}\n";
+    return out.str();
+}
+
+void sim_server::serve_stream(std::istream& in, std::ostream& out)
+{
+    // the answers are written whole, one at a time
+    std::mutex outLock;
+    std::size_t numRequests = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos || line[0] == REQUEST_COMMENT) {
+            continue;
+        }
+        std::size_t requestNumber = ++numRequests;
+        pool.submit([this, line, requestNumber, &out, &outLock]() {
+            std::string reply = answer(line, requestNumber);
+            std::lock_guard<std::mutex> guard(outLock);
+            out << reply << std::flush;
+        });
+    }
+    pool.wait();
+}
+
+void sim_server::serve_socket(const std::string& path)
+{
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("ERROR : server : socket path \"" + path + "\" is too long");
+    }
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        throw std::runtime_error("ERROR : server : unable to make a socket");
+    }
+    // a socket left behind by an earlier server would stop the bind
+    unlink(path.c_str());
+    if (bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listener, SOMAXCONN) != 0) {
+        close(listener);
+        throw std::runtime_error("ERROR : server : unable to listen on \"" + path + "\"");
+    }
+
+    // each client gets a thread to read its requests, the requests themselves go to the pool
+    while (true) {
+        int fd = accept(listener, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            close(listener);
+            throw std::runtime_error("ERROR : server : unable to accept on \"" + path + "\"");
+        }
+        std::thread(&sim_server::serve_connection, this, fd).detach();
+    }
+}
+
+void sim_server::serve_connection(int fd)
+{
+    // the connection stays open until the reader and every answer still running are done with it
+    struct connection {
+        int fd;
+        std::mutex lock;
+        explicit connection(int fd): fd(fd) {}
+        ~connection() { close(fd); }
+    };
+    std::shared_ptr<connection> client = std::make_shared<connection>(fd);
+
+    std::size_t numRequests = 0;
+    std::string pending;
+    char buffer[SERVER_READ_BYTES];
+    while (true) {
+        ssize_t numRead = read(fd, buffer, sizeof(buffer));
+        if (numRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if (numRead <= 0) {
+            break;
+        }
+        pending.append(buffer, numRead);
+
+        // hand each whole line over to the pool
+        std::size_t lineStart = 0;
+        std::size_t lineEnd = 0;
+        while ((lineEnd = pending.find('\n', lineStart)) != std::string::npos) {
+            std::string line = pending.substr(lineStart, lineEnd - lineStart);
+            lineStart = lineEnd + 1;
+            if (line.find_first_not_of(" \t\r") == std::string::npos || line[0] == REQUEST_COMMENT) {
+                continue;
+            }
+            std::size_t requestNumber = ++numRequests;
+            pool.submit([this, client, line, requestNumber]() {
+                std::string reply = answer(line, requestNumber);
+                std::lock_guard<std::mutex> guard(client->lock);
+                // a client that has gone away just misses its answer
+                const char* bytes = reply.data();
+                std::size_t remaining = reply.size();
+                while (remaining > 0) {
+                    ssize_t numSent = send(client->fd, bytes, remaining, MSG_NOSIGNAL);
+                    if (numSent < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    if (numSent <= 0) {
+                        break;
+                    }
+                    bytes += numSent;
+                    remaining -= numSent;
+                }
+            });
+        }
+        pending.erase(0, lineStart);
+    }
+}
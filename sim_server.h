@@ -0,0 +1,80 @@
+#ifndef SIM_SERVER_H
+#define SIM_SERVER_H
+
+#include <string>
+#include <istream>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+#include "types.h"
+#include "process_table.h"
+#include "trace_cache.h"
+#include "latency_histogram.h"
+#include "thread_pool.h"
+#include "mlfq_policy.h"
+#include "cfs_policy.h"
+#include "share_policies.h"
+
+// a request is one line of name=value fields split by spaces, eg.
+// policy=rr quantum=25 trace=processes.csv
+#define REQUEST_FIELD_SEP ' '
+#define REQUEST_VALUE_SEP '='
+// lines starting with this are ignored, as are blank ones
+#define REQUEST_COMMENT '#'
+// a socket connection is read this many bytes at a time
+#define SERVER_READ_BYTES 4096
+
+// one parsed request line, anything not given keeps the same default as the programs
+struct sim_request {
+    // handed back in the answer so a client can match them up, answers can
+    // come back in a different order to the requests
+    std::string id;
+    std::string policy;
+    std::string trace;
+    osp2023::time_type quantum = osp2023::time_not_set;
+    std::size_t levels = MLFQ_DEFAULT_LEVELS;
+    osp2023::time_type boost = MLFQ_DEFAULT_BOOST;
+    osp2023::time_type latency = CFS_DEFAULT_TARGET_LATENCY;
+    osp2023::time_type granularity = CFS_DEFAULT_MIN_GRANULARITY;
+    std::uint64_t seed = LOTTERY_DEFAULT_SEED;
+    // send the per process results back as well as the averages
+    bool rows = false;
+};
+
+/**
+ * a long running simulator that answers requests instead of being started
+ * for every run. the traces stay loaded between requests in a trace_cache
+ * and the requests run on a thread pool, so independent ones run at the same
+ * time. every answer is one line of json with the averages and percentiles.
+ **/
+class sim_server
+{
+    private:
+        trace_cache traces;
+        thread_pool pool;
+
+        // a value of a request field that can't be negative, throws if it isn't one
+        static long long parse_number(const std::string& name, const std::string& value);
+        // the reported percentiles and max as a json object
+        static std::string json_percentiles(const latency_histogram& histogram);
+        // run one request line and give back the json answer, never throws
+        std::string answer(const std::string& line, std::size_t requestNumber);
+        // read requests from a connected socket until the client closes it
+        void serve_connection(int fd);
+    public:
+        // numThreads of 0 means one per core
+        sim_server(std::size_t numThreads, std::size_t maxTraces);
+
+        // read a request line into request, throws if a field is unknown or a value is bad
+        // the fields before the bad one are still filled in
+        static void parse_request(const std::string& line, sim_request& request);
+        // simulate the request on a copy of the processes
+        static process_table simulate(const sim_request& request, const process_table& processes);
+
+        // answer every request from in on out, returns once in runs out and every answer is written
+        void serve_stream(std::istream& in, std::ostream& out);
+        // answer requests from clients of a unix socket made at path, only returns if the socket fails
+        void serve_socket(const std::string& path);
+};
+
+#endif
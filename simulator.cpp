@@ -1,162 +1,121 @@
 #include "simulator.h"
 
-void simulator::print_results(const std::vector<pcb>& processes)
+run_summary simulator::summarise(const process_table& processes)
 {
-    // calculate the total wait time of all processes
-    osp2023::time_type totalWait = std::accumulate(
-        processes.begin(), processes.end(), osp2023::time_zero,
-        [] (osp2023::time_type result, const pcb& process) { 
-            return result + process.getWaitTime(); 
-        }
-    );
+    const std::vector<osp2023::time_type>& waitTimes = processes.getWaitTimes();
+    const std::vector<osp2023::time_type>& turnaroundTimes = processes.getTurnaroundTimes();
+    const std::vector<osp2023::time_type>& responseTimes = processes.getResponseTimes();
 
-    // calculate average wait time of all processes
-    double avgWait = (processes.empty()) ? 0.0 : totalWait / (double)processes.size();
+    // calculate the total wait, turnaround and response times of all processes together
+    run_summary summary;
+    for (std::size_t i = 0; i < processes.size(); ++i) {
+        summary.add(waitTimes[i], turnaroundTimes[i], responseTimes[i]);
+    }
+    return summary;
+}
 
-    // calculate the total turnaround time of all processes
-    osp2023::time_type totalTurnaround = std::accumulate(
-        processes.begin(), processes.end(), osp2023::time_zero,
-        [] (osp2023::time_type result, const pcb& process) { 
-            return result + process.getTurnaroundTime(); 
-        } 
-    );
-    // calculate average turnaround time of all processes
-    double avgTurnaround = (processes.empty()) ? 0.0 : totalTurnaround / (double)processes.size();
-
-    // calculate the total response time of all processes
-    osp2023::time_type totalResponse = std::accumulate(
-        processes.begin(), processes.end(), osp2023::time_zero,
-        [] (osp2023::time_type result, const pcb& process) { 
-            return result + process.getResponseTime(); 
-        } 
-    );
-    // calculate average response time of all processes
-    double avgResponse = (processes.empty()) ? 0.0 : totalResponse / (double)processes.size();
-
-    // print out the header of the tables
-    std::cout << 
-        PROCESS_ID_HEADER << TABLE_VERT_SEP <<
-        BURST_TIME_HEADER << TABLE_VERT_SEP <<
-        WAIT_TIME_HEADER << TABLE_VERT_SEP <<
-        TURNAROUND_TIME_HEADER << TABLE_VERT_SEP <<
-        RESPONSE_TIME_HEADER <<
-        std::endl;
-    
-    // get the length of table header
-    int divisions = NUM_TABLE_COL - 1;
-    std::size_t processIdColLen = strlen(PROCESS_ID_HEADER);
-    std::size_t burstTimeColLen = strlen(BURST_TIME_HEADER);
-    std::size_t waitTimeColLen = strlen(WAIT_TIME_HEADER);
-    std::size_t turnAroundTimeColLen = strlen(TURNAROUND_TIME_HEADER);
-    std::size_t responseTimeColLen = strlen(RESPONSE_TIME_HEADER);
-
-    // calculate the length of a row
-    std::size_t rowLen = 
-        processIdColLen + burstTimeColLen + waitTimeColLen + 
-        turnAroundTimeColLen + responseTimeColLen + divisions;
-
-    // print out the horizontal line below the header
-    std::cout << std::string(rowLen, TABLE_HORZ_SEP) << std::endl;
-
-    // print out each table row
-    for (const pcb& pcb : processes) {
-        std::cout << 
-            std::setw(processIdColLen) << std::left << pcb.getId() << TABLE_VERT_SEP <<
-            std::setw(burstTimeColLen) << std::left << pcb.getBurstTime() << TABLE_VERT_SEP <<
-            std::setw(waitTimeColLen) << std::left << pcb.getWaitTime() << TABLE_VERT_SEP <<
-            std::setw(turnAroundTimeColLen) << std::left << pcb.getTurnaroundTime() << TABLE_VERT_SEP <<
-            std::setw(responseTimeColLen) << std::left << pcb.getResponseTime() <<
-        std::endl;
-    }
-
-    // print out message for no processes
-    if (processes.empty()) {
-        char padChar = ' ';
-        std::string noProcessesMsg = "NO PROCESSES ADDED :C";
-        std::size_t noProcessLeftPad = (rowLen - noProcessesMsg.length()) / 2;
-        std::cout << std::string(noProcessLeftPad, padChar) << noProcessesMsg << std::endl; 
-    }
-    
-    // print out the average times
-    std::cout << std::endl;
-    std::cout << AVG_WAIT_TIME_TITLE << avgWait << std::endl;
-    std::cout << AVG_TURNAROUND_TIME_TITLE << avgTurnaround << std::endl;
-    std::cout << AVG_RESPONSE_TIME_TITLE << avgResponse << std::endl;
-}
-
-void simulator::run_fifo(std::vector<pcb> processes)
-{
-    // --- calculate times --- 
-    if (!processes.empty()) {
-        // set the first process's burst, turnaround and response times
-        pcb& firstProcess = processes.front();
-        firstProcess.setWaitTime(osp2023::time_zero);
-        firstProcess.setResponseTime(osp2023::time_zero);
-        osp2023::time_type firstTurnaround = firstProcess.getBurstTime();
-        firstProcess.setTurnaroundTime(firstTurnaround);
-    }
-    
-    // calculate the times for the rest of the processes
-    std::size_t firstIndexWithWait = 1;
-    for (std::size_t i = firstIndexWithWait; i < processes.size(); ++i) {
-        // get current process
-        pcb& currentProcess = processes.at(i);
-        // get prev process
-        std::size_t prevIndex = i - 1;
-        pcb& prevProcess = processes.at(prevIndex);
-
-        // waitTime = turnaroundTime - burstTime
-        // turnaroundTime = completionTime - arrivalTime
-        // responseTime = firstTime - arrivalTime
+void simulator::print_results(const process_table& processes, const sim_options& options)
+{
+    const std::vector<osp2023::id_type>& ids = processes.getIds();
+    const std::vector<osp2023::time_type>& burstTimes = processes.getBurstTimes();
+    const std::vector<osp2023::time_type>& arrivalTimes = processes.getArrivalTimes();
+    const std::vector<osp2023::time_type>& waitTimes = processes.getWaitTimes();
+    const std::vector<osp2023::time_type>& turnaroundTimes = processes.getTurnaroundTimes();
+    const std::vector<osp2023::time_type>& responseTimes = processes.getResponseTimes();
+
+    // the arrival times only get a column if there are any
+    results_table table(*options.out, options.summary_only, processes.hasArrivalTimes(), 
+        options.percentiles);
+    for (std::size_t i = 0; i < processes.size(); ++i) {
+        table.add(ids[i], burstTimes[i], arrivalTimes[i], waitTimes[i], turnaroundTimes[i], responseTimes[i]);
+    }
+    table.finish();
+}
 
-        // completionTime = waitTime + burstTime 
-        // because arrival time is all 0 and therefore the CPU is not idling
+latency_histograms simulator::latencies(const process_table& processes)
+{
+    const osp2023::time_type* waitTimes = processes.getWaitTimes().data();
+    const osp2023::time_type* turnaroundTimes = processes.getTurnaroundTimes().data();
+    const osp2023::time_type* responseTimes = processes.getResponseTimes().data();
+    std::size_t size = processes.size();
+
+    auto count_block = [&](latency_histograms& histograms, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            histograms.add(waitTimes[i], turnaroundTimes[i], responseTimes[i]);
+        }
+    };
 
-        // because the CPU does not idle and this is fifo
-        // the completion time for a previous process is the waiting for the current process
-        // therefore waitTimeCurrent = waitTimePrevious + burstTimePrevious
-        currentProcess.setWaitTime(
-            prevProcess.getBurstTime() + prevProcess.getWaitTime()
-        );
+    latency_histograms histograms;
+    if (size < PARALLEL_SCAN_MIN_ROWS || std::thread::hardware_concurrency() < 2 ||
+        thread_pool::on_worker()) {
+        count_block(histograms, 0, size);
+        return histograms;
+    }
 
-        // completionTime = waitTime + burstTime
-        // since turnaroundTime = completionTime because arrivalTime = 0
-        // turnaroundTimeCurrent = waitTimeCurrent + burstTimeCurrent
-        currentProcess.setTurnaroundTime(
-            currentProcess.getBurstTime() + currentProcess.getWaitTime()
-        );
+    // every block gets its own histograms, they add up to the same thing
+    thread_pool pool;
+    std::size_t numBlocks = pool.size();
+    std::size_t blockSize = (size + numBlocks - 1) / numBlocks;
+    std::vector<latency_histograms> blocks(numBlocks);
+    for (std::size_t block = 0; block < numBlocks; ++block) {
+        pool.submit([&, block] {
+            std::size_t begin = std::min(size, block * blockSize);
+            std::size_t end = std::min(size, begin + blockSize);
+            count_block(blocks[block], begin, end);
+        });
+    }
+    pool.wait();
 
-        // responseTime = firstTime - arrivalTime
-        // because the CPU does not idle and this is fifo
-        // firstTime = waitTime
-        // therefore responseTimeCurrent = waitTimeCurrent
-        // because arrivalTime = 0
-        currentProcess.setResponseTime(
-            currentProcess.getWaitTime()
-        );
+    for (const latency_histograms& block : blocks) {
+        histograms.merge(block);
     }
+    return histograms;
+}
+
+std::vector<std::size_t> simulator::arrival_order(const process_table& processes)
+{
+    // nothing to sort if everything arrives at the start
+    if (!processes.hasArrivalTimes()) {
+        std::vector<std::size_t> order(processes.size());
+        std::iota(order.begin(), order.end(), 0);
+        return order;
+    }
+    return radix_sort::order(processes.getArrivalTimes());
+}
+
+void simulator::run_fifo(process_table processes,
+    const sim_options& options)
+{
+    schedule_fifo(processes);
 
     // --- print the results ---
     // response time is the same as turn around time
-    print_results(processes);
+    print_results(processes, options);
 }
 
-void simulator::run_sjf(std::vector<pcb> processes)
+void simulator::schedule_fifo(process_table& processes)
 {
-    // --- sort the processes by burst times (and then the order they appear in) ---
-    // keep in mind we are sorting a copy of the pcb vector
-    std::stable_sort(processes.begin(), processes.end(), 
-        [](const pcb& left, const pcb& right) {
-            return left.getBurstTime() < right.getBurstTime();
-        }
-    );
+    fifo_policy policy;
+    simulate(policy, processes);
+}
 
+void simulator::run_sjf(process_table processes,
+    const sim_options& options)
+{
+    schedule_sjf(processes);
+    print_results(processes, options);
+}
+
+void simulator::schedule_sjf(process_table& processes)
+{
+    // keep in mind we are sorting a copy of the process table
     // the rest is the the same as fifo
-    // so I'm just running fifo for the sorted processes
-    run_fifo(processes);
+    sjf_policy policy;
+    simulate(policy, processes);
 }
 
-void simulator::run_rr(osp2023::time_type quantum, std::vector<pcb> processes)
+void simulator::run_rr(osp2023::time_type quantum, process_table processes,
+    const sim_options& options)
 {
     // check if quantum is not negative
     if (quantum < pcb::MIN_DURATION || quantum > pcb::MAX_DURATION) {
@@ -166,209 +125,1084 @@ void simulator::run_rr(osp2023::time_type quantum, std::vector<pcb> processes)
             throw std::runtime_error(error);
     }
 
-    bool finished = false;
-    osp2023::time_type curr_completion = osp2023::time_zero;
+    schedule_rr(quantum, processes);
 
-    while (!finished)
-    {
-        bool allExecuted = true;
+    // print the results
+    print_results(processes, options);
+}
 
-        for (pcb& process: processes) {
-            
-            // check if the process still needs to be executed
-            if (process.getTimeUsed() < process.getBurstTime()) {
-                
-                // if we reached here then there are processes that are not finished
-                allExecuted = false;
+void simulator::schedule_rr(osp2023::time_type quantum, process_table& processes)
+{
+    rr_policy policy(quantum);
+    simulate(policy, processes);
+}
 
-                // set the time elapsed
-                osp2023::time_type timeElapsed = osp2023::time_zero;
-                if (process.getTimeUsed() + quantum <= process.getBurstTime()) {
-                    // if adding the quantum doesn't end the process or just barely
-                    // then the elapsed time will be the quantum time
-                    timeElapsed = quantum;
-                } else {
-                    // if adding the quantum ends the process (and not barely)
-                    // then the elapsed time will the difference between burst time and used time
-                    timeElapsed = process.getBurstTime() - process.getTimeUsed();
-                }
+void simulator::run_fifo_queue(process_table processes,
+    const sim_options& options)
+{
+    schedule_fifo_queue(processes);
 
-                // check if this the first time the process is being executed
-                if (process.getTimeUsed() == osp2023::time_zero) {
-                    // responseTime = firstTime - arrivalTime
-                    // since arrivalTime = 0
-                    // then responseTime = firstTime
-                    process.setResponseTime(
-                        curr_completion
-                    );
-                }
+    // print the results
+    print_results(processes, options);
+}
 
-                // elapse the time
-                curr_completion += timeElapsed;
-                // update the time used for the process
-                process.setTimeUsed(process.getTimeUsed() + timeElapsed);
-
-                // check if the process is finished
-                if (process.getTimeUsed() == process.getBurstTime()) {
-
-                    // turnaroundTime = completionTime - arrivalTime
-                    // since arrivalTime = 0
-                    // then turnaroundTime = completionTime 
-                    process.setTurnaroundTime(
-                        curr_completion
-                    );
-
-                    // waitTime = turnaroundTime - burstTime
-                    process.setWaitTime(
-                        process.getTurnaroundTime() - process.getBurstTime()
-                    );
-                }
-            }
+void simulator::schedule_fifo_queue(process_table& processes)
+{
+    fifo_queue_policy policy;
+    simulate(policy, processes);
+}
+
+void simulator::run_sjf_queue(process_table processes,
+    const sim_options& options)
+{
+    schedule_sjf_queue(processes);
+    print_results(processes, options);
+}
+
+void simulator::schedule_sjf_queue(process_table& processes)
+{
+    // pretty much the same as schedule_sjf
+    // but the ready processes go through a queue one at a time
+    sjf_queue_policy policy;
+    simulate(policy, processes);
+}
+
+void simulator::run_rr_queue(osp2023::time_type quantum, process_table processes,
+    const sim_options& options)
+{
+    // check if quantum is not negative
+    if (quantum < pcb::MIN_DURATION || quantum > pcb::MAX_DURATION) {
+        std::string error 
+            = "ERROR : simulator : run rr queue quantum must be between " + 
+            std::to_string(pcb::MIN_DURATION) + " and " + std::to_string(pcb::MAX_DURATION);
+            throw std::runtime_error(error);
+    }
+
+    schedule_rr_queue(quantum, processes);
+
+    // print results
+    print_results(processes, options);
+}
+
+void simulator::schedule_rr_queue(osp2023::time_type quantum, process_table& processes)
+{
+    rr_queue_policy policy(quantum);
+    simulate(policy, processes);
+}
+
+void simulator::run_rr_rounds(osp2023::time_type quantum, process_table processes,
+    const sim_options& options)
+{
+    // check if quantum is not negative
+    if (quantum < pcb::MIN_DURATION || quantum > pcb::MAX_DURATION) {
+        std::string error 
+            = "ERROR : simulator : run rr rounds quantum must be between " + 
+            std::to_string(pcb::MIN_DURATION) + " and " + std::to_string(pcb::MAX_DURATION);
+            throw std::runtime_error(error);
+    }
+
+    schedule_rr_rounds(quantum, processes);
+
+    // print results
+    print_results(processes, options);
+}
+
+void simulator::schedule_rr_rounds(osp2023::time_type quantum, process_table& processes)
+{
+    // the rounds below only hold when every process is there from the start
+    if (processes.hasArrivalTimes()) {
+        throw std::runtime_error("ERROR : simulator : rr rounds needs every process to arrive at 0");
+    }
+
+    const osp2023::time_type* burstTimes = processes.getBurstTimes().data();
+    osp2023::time_type* timesUsed = processes.getTimesUsed().data();
+    osp2023::time_type* waitTimes = processes.getWaitTimes().data();
+    osp2023::time_type* turnaroundTimes = processes.getTurnaroundTimes().data();
+    osp2023::time_type* responseTimes = processes.getResponseTimes().data();
+
+    // how many times each process gets put on the cpu
+    // a process with a burst time of 0 is still dispatched once (for no time)
+    // just like it is in run_rr_queue
+    std::vector<osp2023::time_type> slices(processes.size());
+    // the length of the last slice each process gets before it finishes
+    std::vector<osp2023::time_type> lastSlice(processes.size());
+
+    // every process is dispatched once in the first round in file order
+    // so responseTime = the sum of the first slices of the processes before it
+    osp2023::time_type firstRoundTime = osp2023::time_zero;
+    for (std::size_t i = 0; i < processes.size(); ++i) {
+        osp2023::time_type burstTime = burstTimes[i];
+
+        slices[i] = std::max<osp2023::time_type>(1, (burstTime + quantum - 1) / quantum);
+        lastSlice[i] = burstTime - (slices[i] - 1) * quantum;
+
+        responseTimes[i] = firstRoundTime;
+        firstRoundTime += std::min(quantum, burstTime);
+        timesUsed[i] = burstTime;
+    }
+
+    // visit the processes in the order they finish their rounds
+    // ties stay in file order, which is the order they finish within a round
+    std::vector<std::size_t> order(processes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&slices](std::size_t left, std::size_t right) {
+            return slices[left] < slices[right];
+        }
+    );
+
+    // marks which processes are still in the queue, indexed by file order
+    fenwick_tree active(std::vector<osp2023::time_type>(processes.size(), 1));
+    osp2023::time_type numActive = processes.size();
+
+    // the time at the start of the round we are up to
+    osp2023::time_type roundStart = osp2023::time_zero;
+    osp2023::time_type currentRound = 1;
+
+    std::size_t groupBegin = 0;
+    while (groupBegin < order.size()) {
+        // find every process that finishes in the same round
+        osp2023::time_type finishRound = slices[order[groupBegin]];
+        std::size_t groupEnd = groupBegin;
+        while (groupEnd < order.size() && slices[order[groupEnd]] == finishRound) {
+            ++groupEnd;
+        }
+
+        // nobody finishes in the rounds before finishRound
+        // so every active process uses its full quantum in each of them
+        roundStart += (finishRound - currentRound) * numActive * quantum;
+
+        // within the finishing round, a process completes after
+        // a full quantum for every active process before it that keeps going
+        // and the last slice of every process before it that also finishes
+        osp2023::time_type finishedBefore = 0;
+        osp2023::time_type lastSlicesBefore = osp2023::time_zero;
+        for (std::size_t g = groupBegin; g < groupEnd; ++g) {
+            std::size_t i = order[g];
+
+            osp2023::time_type activeBefore = active.prefix_sum(i);
+            osp2023::time_type completion = roundStart + 
+                (activeBefore - finishedBefore) * quantum + lastSlicesBefore + lastSlice[i];
+
+            // turnaroundTime = completionTime because arrivalTime = 0
+            turnaroundTimes[i] = completion;
+            // waitTime = turnaroundTime - burstTime
+            waitTimes[i] = completion - burstTimes[i];
+
+            ++finishedBefore;
+            lastSlicesBefore += lastSlice[i];
         }
 
-        // if all proccesses are finished executing, then we are finished
-        if (allExecuted) {
-            finished = true;
+        // move the clock to the end of the finishing round
+        // and take the finished processes out of the queue
+        roundStart += (numActive - finishedBefore) * quantum + lastSlicesBefore;
+        for (std::size_t g = groupBegin; g < groupEnd; ++g) {
+            active.add(order[g], -1);
         }
+        numActive -= finishedBefore;
+        currentRound = finishRound + 1;
+
+        groupBegin = groupEnd;
     }
 
-    // print the results
-    print_results(processes);
-}
-
-void simulator::run_fifo_queue(std::vector<pcb> processes) {
-    // insert vector of processes into queue
-    // since we want to modify it, its references of pcb
-    std::deque<pcb*> readyQueue;
-    for (pcb& process: processes) {
-        readyQueue.push_back(&process);
-    }
-
-    osp2023::time_type firstTurnaround;
-    if (!readyQueue.empty()) {
-        // set the first process's burst, turnaround and response times
-        pcb* firstProccess = readyQueue.front();
-        firstProccess->setWaitTime(osp2023::time_zero);
-        firstProccess->setResponseTime(osp2023::time_zero);
-        firstTurnaround = firstProccess->getBurstTime();
-        firstProccess->setTurnaroundTime(firstTurnaround);
-        readyQueue.pop_front();
-    }
-
-    // set the rest of the processes' burst, turnaround and response times
-    osp2023::time_type curr_completion = firstTurnaround;
-    while (!readyQueue.empty()) {
-        // get the current process
-        pcb* currentProcess = readyQueue.front();
-        // calculate the times (and increment the current completion time)
-        osp2023::time_type wait_time = curr_completion;
-        osp2023::time_type response_time = curr_completion;
-        curr_completion += currentProcess->getBurstTime();
-        osp2023::time_type turnaround_time = curr_completion;
-        // set the times
-        currentProcess->setWaitTime(wait_time);
-        currentProcess->setResponseTime(response_time);
-        currentProcess->setTurnaroundTime(turnaround_time);
-        // pop the current element
-        readyQueue.pop_front();
+}
+
+std::vector<sweep_result> simulator::sweep_rr(const process_table& processes,
+    osp2023::time_type minQuantum, osp2023::time_type maxQuantum, bool withPercentiles)
+{
+    // check if the quanta are in range
+    if (minQuantum < pcb::MIN_DURATION || maxQuantum > pcb::MAX_DURATION || minQuantum > maxQuantum) {
+        std::string error 
+            = "ERROR : simulator : sweep rr quanta must be between " + 
+            std::to_string(pcb::MIN_DURATION) + " and " + std::to_string(pcb::MAX_DURATION);
+            throw std::runtime_error(error);
     }
 
-    // print the results
-    print_results(processes);
+    // one slot per quantum, each task only ever writes its own slot
+    std::vector<sweep_result> results(maxQuantum - minQuantum + 1);
+
+    thread_pool pool;
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        osp2023::time_type quantum = minQuantum + i;
+        sweep_result& result = results[i];
+        pool.submit([&processes, &result, quantum, withPercentiles] {
+            // the shared table is only read, each simulation gets its own copy
+            process_table copy = processes;
+            if (copy.hasArrivalTimes()) {
+                // the round skipping engine assumes everything arrives at 0
+                schedule_events(event_policy::RR, quantum, copy);
+            } else {
+                schedule_rr_rounds(quantum, copy);
+            }
+            result.quantum = quantum;
+            result.summary = summarise(copy);
+
+            // every core is already busy with a quantum, so the times are counted right here
+            if (withPercentiles) {
+                latency_histograms histograms;
+                for (std::size_t row = 0; row < copy.size(); ++row) {
+                    histograms.add(copy.getWaitTimes()[row], copy.getTurnaroundTimes()[row],
+                        copy.getResponseTimes()[row]);
+                }
+                result.waitPercentiles = histograms.wait.report();
+                result.turnaroundPercentiles = histograms.turnaround.report();
+                result.responsePercentiles = histograms.response.report();
+            }
+        });
+    }
+    pool.wait();
+
+    return results;
 }
 
-void simulator::run_sjf_queue(std::vector<pcb> processes)
+void simulator::print_sweep(const std::vector<sweep_result>& results, const sim_options& options)
 {
-    // pretty much the same as run_sjf
-    // but we are calling run_fifo_queue instead of run_fifo at the end
+    std::ostream& out = *options.out;
+
+    // get the length of each column from the table header
+    std::size_t quantumColLen = strlen(QUANTUM_HEADER);
+    std::size_t waitTimeColLen = strlen(AVG_WAIT_TIME_HEADER);
+    std::size_t turnAroundTimeColLen = strlen(AVG_TURNAROUND_TIME_HEADER);
+    std::size_t responseTimeColLen = strlen(AVG_RESPONSE_TIME_HEADER);
+    std::size_t rowLen = quantumColLen + waitTimeColLen + turnAroundTimeColLen + 
+        responseTimeColLen + NUM_SWEEP_TABLE_COL - 1;
+
+    // the lowest average of each kind wins, the smallest quantum wins a tie
+    const sweep_result* bestWait = nullptr;
+    const sweep_result* bestTurnaround = nullptr;
+    const sweep_result* bestResponse = nullptr;
+
+    // the table is skipped in summary only mode
+    if (!options.summary_only) {
+        out << 
+            QUANTUM_HEADER << TABLE_VERT_SEP <<
+            AVG_WAIT_TIME_HEADER << TABLE_VERT_SEP <<
+            AVG_TURNAROUND_TIME_HEADER << TABLE_VERT_SEP <<
+            AVG_RESPONSE_TIME_HEADER << '\n';
+        out << std::string(rowLen, TABLE_HORZ_SEP) << '\n';
+    }
 
-    // --- sort the processes by burst times (and then the order they appear in) ---
-    // keep in mind we are sorting a copy of the pcb vector
-    std::stable_sort(processes.begin(), processes.end(), 
-        [](const pcb& left, const pcb& right) {
-            return left.getBurstTime() < right.getBurstTime();
+    for (const sweep_result& result : results) {
+        const run_summary& summary = result.summary;
+        if (bestWait == nullptr || summary.getAvgWait() < bestWait->summary.getAvgWait()) {
+            bestWait = &result;
+        }
+        if (bestTurnaround == nullptr || 
+            summary.getAvgTurnaround() < bestTurnaround->summary.getAvgTurnaround()) {
+            bestTurnaround = &result;
+        }
+        if (bestResponse == nullptr || 
+            summary.getAvgResponse() < bestResponse->summary.getAvgResponse()) {
+            bestResponse = &result;
         }
-    );
 
-    // the rest is the the same as fifo
-    // so I'm just running fifo for the sorted processes
-    run_fifo_queue(processes);
+        if (!options.summary_only) {
+            out << 
+                std::setw(quantumColLen) << std::left << result.quantum << TABLE_VERT_SEP <<
+                std::setw(waitTimeColLen) << std::left << summary.getAvgWait() << TABLE_VERT_SEP <<
+                std::setw(turnAroundTimeColLen) << std::left << summary.getAvgTurnaround() << TABLE_VERT_SEP <<
+                std::setw(responseTimeColLen) << std::left << summary.getAvgResponse() << '\n';
+            // the spread of the times goes under the quantum's averages
+            if (options.percentiles) {
+                results_table::print_percentiles(out, WAIT_TIME_PERCENTILES_TITLE, result.waitPercentiles);
+                results_table::print_percentiles(out, TURNAROUND_TIME_PERCENTILES_TITLE,
+                    result.turnaroundPercentiles);
+                results_table::print_percentiles(out, RESPONSE_TIME_PERCENTILES_TITLE,
+                    result.responsePercentiles);
+            }
+        }
+    }
+
+    if (!options.summary_only) {
+        out << '\n';
+    }
+
+    // print out the best quantum for each average
+    if (bestWait != nullptr) {
+        out << BEST_WAIT_TIME_TITLE << bestWait->quantum << 
+            " (avg. " << bestWait->summary.getAvgWait() << ")" << '\n';
+        out << BEST_TURNAROUND_TIME_TITLE << bestTurnaround->quantum << 
+            " (avg. " << bestTurnaround->summary.getAvgTurnaround() << ")" << '\n';
+        out << BEST_RESPONSE_TIME_TITLE << bestResponse->quantum << 
+            " (avg. " << bestResponse->summary.getAvgResponse() << ")" << '\n';
+    }
+    out.flush();
 }
 
-void simulator::run_rr_queue(osp2023::time_type quantum, std::vector<pcb> processes)
+void simulator::run_fifo_events(process_table processes, const sim_options& options)
+{
+    schedule_events(event_policy::FIFO, osp2023::time_not_set, processes);
+    print_results(processes, options);
+}
+
+void simulator::run_sjf_events(process_table processes, const sim_options& options)
+{
+    schedule_events(event_policy::SJF, osp2023::time_not_set, processes);
+    print_results(processes, options);
+}
+
+void simulator::run_rr_events(osp2023::time_type quantum, process_table processes,
+    const sim_options& options)
 {
     // check if quantum is not negative
     if (quantum < pcb::MIN_DURATION || quantum > pcb::MAX_DURATION) {
         std::string error 
-            = "ERROR : simulator : run rr queue quantum must be between " + 
+            = "ERROR : simulator : run rr events quantum must be between " + 
             std::to_string(pcb::MIN_DURATION) + " and " + std::to_string(pcb::MAX_DURATION);
             throw std::runtime_error(error);
     }
 
-    // insert vector of processes into queue
-    // since we want to modify it, its references of pcb
-    std::deque<pcb*> readyQueue;
-    for (pcb& process: processes) {
-        readyQueue.push_back(&process);
+    schedule_events(event_policy::RR, quantum, processes);
+    print_results(processes, options);
+}
+
+void simulator::schedule_events(event_policy policy, osp2023::time_type quantum, 
+    process_table& processes)
+{
+    const std::vector<osp2023::time_type>& burstTimes = processes.getBurstTimes();
+    const std::vector<osp2023::time_type>& arrivalTimes = processes.getArrivalTimes();
+    std::vector<osp2023::time_type>& timesUsed = processes.getTimesUsed();
+    std::vector<osp2023::time_type>& waitTimes = processes.getWaitTimes();
+    std::vector<osp2023::time_type>& turnaroundTimes = processes.getTurnaroundTimes();
+    std::vector<osp2023::time_type>& responseTimes = processes.getResponseTimes();
+
+    // every process starts off as an arrival event
+    std::vector<sim_event> arrivals(processes.size());
+    for (std::size_t i = 0; i < processes.size(); ++i) {
+        arrivals[i] = {arrivalTimes[i], event_type::ARRIVAL, i};
+    }
+    event_queue events;
+    events.assign(std::move(arrivals));
+
+    // fifo and rr take processes in the order they arrived
+    // a process is only ever waiting in the queue once, so one slot each is enough
+    index_ring readyQueue;
+    if (policy != event_policy::SJF) {
+        readyQueue.reserve(processes.size());
     }
+    // sjf takes the shortest burst time, then the one first in the file
+    std::priority_queue<
+        std::pair<osp2023::time_type, std::size_t>,
+        std::vector<std::pair<osp2023::time_type, std::size_t>>,
+        std::greater<std::pair<osp2023::time_type, std::size_t>>
+    > shortestFirst;
+
+    // the process on the cpu and how long it was given
+    bool cpuBusy = false;
+    std::size_t running = 0;
+    osp2023::time_type runningSlice = osp2023::time_zero;
+
+    while (!events.empty()) {
+        sim_event event = events.pop();
+        osp2023::time_type now = event.time;
+
+        switch (event.type) {
+            case event_type::ARRIVAL:
+                if (policy == event_policy::SJF) {
+                    shortestFirst.push({burstTimes[event.process], event.process});
+                } else {
+                    readyQueue.push(event.process);
+                }
+                break;
+
+            case event_type::COMPLETION:
+                timesUsed[running] += runningSlice;
+                // turnaroundTime = completionTime - arrivalTime
+                turnaroundTimes[running] = now - arrivalTimes[running];
+                // waitTime = turnaroundTime - burstTime
+                waitTimes[running] = turnaroundTimes[running] - burstTimes[running];
+                cpuBusy = false;
+                break;
+
+            case event_type::QUANTUM_EXPIRY:
+                // the process goes to the back of the queue
+                // behind anything that arrived at the same time
+                timesUsed[running] += runningSlice;
+                readyQueue.push(running);
+                cpuBusy = false;
+                break;
+        }
+
+        // only pick the next process once everything at this time has happened
+        if (cpuBusy || (!events.empty() && events.top().time == now)) {
+            continue;
+        }
 
-    osp2023::time_type curr_completion = osp2023::time_zero;
-    while (!readyQueue.empty()) {
-        // get the current process in the queue
-        pcb* currentProcess = readyQueue.front();
-        // pop the process off the queue
-        readyQueue.pop_front();
+        bool haveReady = (policy == event_policy::SJF) ? !shortestFirst.empty() : !readyQueue.empty();
+        if (!haveReady) {
+            // the cpu idles until the next arrival, which is the next event anyway
+            continue;
+        }
 
-        // set the time elapsed
-        osp2023::time_type timeElapsed = osp2023::time_zero;
-        if (currentProcess->getTimeUsed() + quantum <= currentProcess->getBurstTime()) {
-            // if adding the quantum doesn't end the process or just barely
-            // then the elapsed time will be the quantum time
-            timeElapsed = quantum;
+        // put the next process on the cpu
+        if (policy == event_policy::SJF) {
+            running = shortestFirst.top().second;
+            shortestFirst.pop();
         } else {
-            // if adding the quantum ends the process (and not barely)
-            // then the elapsed time will the difference between burst time and used time
-            timeElapsed = currentProcess->getBurstTime() - currentProcess->getTimeUsed();
+            running = readyQueue.pop();
         }
+        cpuBusy = true;
 
-        // check if this the first time the process is being executed
-        if (currentProcess->getTimeUsed() == osp2023::time_zero) {
-            // responseTime = firstTime - arrivalTime
-            // since arrivalTime = 0
-            // then responseTime = firstTime
-            currentProcess->setResponseTime(
-                curr_completion
-            );
+        // responseTime = firstTime - arrivalTime
+        if (responseTimes[running] == osp2023::time_not_set) {
+            responseTimes[running] = now - arrivalTimes[running];
         }
 
-        // elapse the time
-        curr_completion += timeElapsed;
-        // update the time used for the process
-        currentProcess->setTimeUsed(currentProcess->getTimeUsed() + timeElapsed);
+        // fifo and sjf run the process to the end, rr gives it at most a quantum
+        osp2023::time_type remaining = burstTimes[running] - timesUsed[running];
+        runningSlice = (policy == event_policy::RR) ? std::min(quantum, remaining) : remaining;
+        event_type outcome = (runningSlice == remaining) ? 
+            event_type::COMPLETION : event_type::QUANTUM_EXPIRY;
+        events.push({now + runningSlice, outcome, running});
+    }
+}
 
-        // check if the process is finished
-        if (currentProcess->getTimeUsed() == currentProcess->getBurstTime()) {
+void simulator::run_srtf(process_table processes, const sim_options& options)
+{
+    schedule_srtf(processes);
+    print_results(processes, options);
+}
 
-            // turnaroundTime = completionTime - arrivalTime
-            // since arrivalTime = 0
-            // then turnaroundTime = completionTime 
-            currentProcess->setTurnaroundTime(
-                curr_completion
-            );
+void simulator::schedule_srtf(process_table& processes)
+{
+    const std::vector<osp2023::time_type>& burstTimes = processes.getBurstTimes();
+    const std::vector<osp2023::time_type>& arrivalTimes = processes.getArrivalTimes();
+    std::vector<osp2023::time_type>& timesUsed = processes.getTimesUsed();
+    std::vector<osp2023::time_type>& waitTimes = processes.getWaitTimes();
+    std::vector<osp2023::time_type>& turnaroundTimes = processes.getTurnaroundTimes();
+    std::vector<osp2023::time_type>& responseTimes = processes.getResponseTimes();
+
+    // the ready processes keyed by (time left, row) so ties go to file order
+    // the running process stays in the heap with a row of -1, it is always on top
+    // and it keeps the cpu when a new process has the same amount of time left
+    // as its time left goes down its key is lowered in place
+    addressable_heap ready(processes.size());
+    const osp2023::time_type RUNNING_RANK = -1;
+    const std::size_t NOT_RUNNING = processes.size();
+
+    std::vector<std::size_t> arrivals = arrival_order(processes);
+    std::size_t nextArrival = 0;
+
+    osp2023::time_type now = osp2023::time_zero;
+    std::size_t running = NOT_RUNNING;
+
+    while (nextArrival < arrivals.size() || !ready.empty()) {
+        // jump over idle time to the next arrival
+        if (ready.empty()) {
+            now = std::max(now, arrivalTimes[arrivals[nextArrival]]);
+        }
+        // everything that has arrived by now joins the ready heap
+        while (nextArrival < arrivals.size() && arrivalTimes[arrivals[nextArrival]] <= now) {
+            std::size_t row = arrivals[nextArrival++];
+            ready.push(row, {burstTimes[row], (osp2023::time_type)row});
+        }
+
+        // the process with the least time left gets the cpu
+        std::size_t current = ready.top();
+        if (current != running) {
+            // a preempted process goes back to competing on its row
+            if (running != NOT_RUNNING && ready.contains(running)) {
+                ready.update(running, {ready.key(running).primary, (osp2023::time_type)running});
+            }
+            running = current;
+            ready.decrease_key(running, {ready.key(running).primary, RUNNING_RANK});
+
+            // responseTime = firstTime - arrivalTime
+            if (responseTimes[running] == osp2023::time_not_set) {
+                responseTimes[running] = now - arrivalTimes[running];
+            }
+        }
 
+        // run until the process finishes or the next arrival, whichever is first
+        osp2023::time_type remaining = ready.top_key().primary;
+        osp2023::time_type untilArrival = (nextArrival < arrivals.size()) ?
+            arrivalTimes[arrivals[nextArrival]] - now : remaining;
+        if (remaining <= untilArrival) {
+            now += remaining;
+            timesUsed[running] = burstTimes[running];
+            // turnaroundTime = completionTime - arrivalTime
+            turnaroundTimes[running] = now - arrivalTimes[running];
             // waitTime = turnaroundTime - burstTime
-            currentProcess->setWaitTime(
-                currentProcess->getTurnaroundTime() - currentProcess->getBurstTime()
-            );
-        } 
-        else
-        {
-            // if the process is not finished yet
-            // then we want to add it back to the end of the queue
-            readyQueue.push_back(currentProcess);
+            waitTimes[running] = turnaroundTimes[running] - burstTimes[running];
+            ready.pop();
+            running = NOT_RUNNING;
+        } else {
+            // the running process keeps the top spot while its time left shrinks
+            now += untilArrival;
+            timesUsed[running] += untilArrival;
+            ready.decrease_key(running, {remaining - untilArrival, RUNNING_RANK});
         }
     }
+}
+
+void simulator::run_mlfq(osp2023::time_type quantum, std::size_t numLevels, 
+    osp2023::time_type boostPeriod, process_table processes, const sim_options& options)
+{
+    // check if quantum is not negative
+    if (quantum < pcb::MIN_DURATION || quantum > pcb::MAX_DURATION) {
+        std::string error 
+            = "ERROR : simulator : run mlfq quantum must be between " + 
+            std::to_string(pcb::MIN_DURATION) + " and " + std::to_string(pcb::MAX_DURATION);
+            throw std::runtime_error(error);
+    }
+
+    schedule_mlfq(quantum, numLevels, boostPeriod, processes);
+
+    // print results
+    print_results(processes, options);
+}
+
+void simulator::schedule_mlfq(osp2023::time_type quantum, std::size_t numLevels, 
+    osp2023::time_type boostPeriod, process_table& processes)
+{
+    mlfq_policy policy(quantum, numLevels, boostPeriod);
+    simulate(policy, processes);
+}
+
+void simulator::run_cfs(osp2023::time_type targetLatency, osp2023::time_type minGranularity,
+    process_table processes, const sim_options& options)
+{
+    schedule_cfs(targetLatency, minGranularity, processes);
+
+    // print results
+    print_results(processes, options);
+}
+
+void simulator::schedule_cfs(osp2023::time_type targetLatency, osp2023::time_type minGranularity,
+    process_table& processes)
+{
+    cfs_policy policy(targetLatency, minGranularity);
+    simulate(policy, processes);
+}
+
+void simulator::run_lottery(osp2023::time_type quantum, std::uint64_t seed, 
+    process_table processes, const sim_options& options)
+{
+    // check if quantum is not negative
+    if (quantum < pcb::MIN_DURATION || quantum > pcb::MAX_DURATION) {
+        std::string error 
+            = "ERROR : simulator : run lottery quantum must be between " + 
+            std::to_string(pcb::MIN_DURATION) + " and " + std::to_string(pcb::MAX_DURATION);
+            throw std::runtime_error(error);
+    }
+
+    schedule_lottery(quantum, seed, processes);
+
+    // print results
+    print_results(processes, options);
+}
+
+void simulator::schedule_lottery(osp2023::time_type quantum, std::uint64_t seed, 
+    process_table& processes)
+{
+    lottery_policy policy(quantum, seed);
+    simulate(policy, processes);
+}
+
+void simulator::run_stride(osp2023::time_type quantum, process_table processes, 
+    const sim_options& options)
+{
+    // check if quantum is not negative
+    if (quantum < pcb::MIN_DURATION || quantum > pcb::MAX_DURATION) {
+        std::string error 
+            = "ERROR : simulator : run stride quantum must be between " + 
+            std::to_string(pcb::MIN_DURATION) + " and " + std::to_string(pcb::MAX_DURATION);
+            throw std::runtime_error(error);
+    }
+
+    schedule_stride(quantum, processes);
 
     // print results
-    print_results(processes);
-}
\ No newline at end of file
+    print_results(processes, options);
+}
+
+void simulator::schedule_stride(osp2023::time_type quantum, process_table& processes)
+{
+    stride_policy policy(quantum);
+    simulate(policy, processes);
+}
+
+void simulator::stream_fifo(const std::string& fileName, const sim_options& options)
+{
+    // only the clock carries on from one process to the next, so every batch
+    // is printed and thrown away before the next one is read
+    trace_stream trace(fileName);
+    results_table table(*options.out, options.summary_only, trace.hasArrivalTimes(), 
+        options.percentiles);
+
+    osp2023::time_type clock = osp2023::time_zero;
+    osp2023::time_type lastArrival = osp2023::time_zero;
+    process_table batch;
+    while (trace.next_batch(batch)) {
+        const std::vector<osp2023::id_type>& ids = batch.getIds();
+        const std::vector<osp2023::time_type>& burstTimes = batch.getBurstTimes();
+        const std::vector<osp2023::time_type>& arrivalTimes = batch.getArrivalTimes();
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            // there's no going back to run a process that turns up late
+            if (arrivalTimes[i] < lastArrival) {
+                std::string error = "ERROR : stream : fifo needs the processes in arrival order : process " +
+                    std::to_string(ids[i]) + " arrives before the one above it";
+                throw std::runtime_error(error);
+            }
+            lastArrival = arrivalTimes[i];
+
+            // the cpu sits idle until the process arrives, then runs it to the end
+            clock = std::max(clock, arrivalTimes[i]);
+            osp2023::time_type waitTime = clock - arrivalTimes[i];
+            clock += burstTimes[i];
+            table.add(ids[i], burstTimes[i], arrivalTimes[i], 
+                waitTime, waitTime + burstTimes[i], waitTime);
+        }
+    }
+    table.finish();
+}
+
+template <typename Emit>
+void simulator::merge_runs(std::vector<std::unique_ptr<spill_file>>& runs, 
+    std::size_t first, std::size_t last, Emit emit)
+{
+    // the smallest key at the front of each run, ties go to the earlier run
+    // which holds the processes from earlier in the file, so the merge is stable
+    std::priority_queue<std::pair<osp2023::time_type, std::size_t>,
+        std::vector<std::pair<osp2023::time_type, std::size_t>>,
+        std::greater<std::pair<osp2023::time_type, std::size_t>>> fronts;
+    std::vector<spill_record> records(last - first);
+    for (std::size_t i = first; i < last; ++i) {
+        runs[i]->rewind();
+        if (runs[i]->read(records[i - first])) {
+            fronts.push({records[i - first].key, i});
+        }
+    }
+
+    while (!fronts.empty()) {
+        std::size_t run = fronts.top().second;
+        fronts.pop();
+        emit(records[run - first]);
+        if (runs[run]->read(records[run - first])) {
+            fronts.push({records[run - first].key, run});
+        }
+    }
+
+    // the runs have been used up, give their disk space back
+    for (std::size_t i = first; i < last; ++i) {
+        runs[i].reset();
+    }
+}
+
+void simulator::stream_sjf(const std::string& fileName, const sim_options& options)
+{
+    trace_stream trace(fileName);
+
+    // sort the trace a run at a time, every run that fills up is spilled to a temp file
+    std::vector<std::unique_ptr<spill_file>> runs;
+    std::vector<osp2023::time_type> burstTimes;
+    std::vector<osp2023::id_type> ids;
+    auto spill_run = [&]() {
+        std::unique_ptr<spill_file> run = std::make_unique<spill_file>();
+        for (std::size_t row : radix_sort::order(burstTimes)) {
+            run->write({burstTimes[row], ids[row]});
+        }
+        runs.push_back(std::move(run));
+        burstTimes.clear();
+        ids.clear();
+    };
+
+    process_table batch;
+    while (trace.next_batch(batch)) {
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            // a process arriving later might have to run before ones that were already printed
+            if (batch.getArrivalTimes()[i] != osp2023::time_zero) {
+                std::string error = "ERROR : stream : sjf needs every process to arrive at 0 : process " +
+                    std::to_string(batch.getIds()[i]) + " arrives at " + 
+                    std::to_string(batch.getArrivalTimes()[i]);
+                throw std::runtime_error(error);
+            }
+            burstTimes.push_back(batch.getBurstTimes()[i]);
+            ids.push_back(batch.getIds()[i]);
+            if (burstTimes.size() == STREAM_RUN_ROWS) {
+                spill_run();
+            }
+        }
+    }
+
+    // everything is sorted now so the table can start, every process
+    // arrived at 0 so there is no arrival time column
+    results_table table(*options.out, options.summary_only, false, options.percentiles);
+    osp2023::time_type clock = osp2023::time_zero;
+    auto emit = [&](const spill_record& record) {
+        table.add(record.id, record.key, osp2023::time_zero, clock, clock + record.key, clock);
+        clock += record.key;
+    };
+
+    if (runs.empty()) {
+        // the whole trace fit in one run, so there is nothing to merge
+        for (std::size_t row : radix_sort::order(burstTimes)) {
+            emit({burstTimes[row], ids[row]});
+        }
+    } else {
+        if (!burstTimes.empty()) {
+            spill_run();
+        }
+        burstTimes = {};
+        ids = {};
+
+        // too many runs to read at once get merged into fewer longer runs first
+        while (runs.size() > STREAM_MERGE_WAYS) {
+            std::vector<std::unique_ptr<spill_file>> merged;
+            for (std::size_t first = 0; first < runs.size(); first += STREAM_MERGE_WAYS) {
+                std::unique_ptr<spill_file> run = std::make_unique<spill_file>();
+                merge_runs(runs, first, std::min(runs.size(), first + STREAM_MERGE_WAYS), 
+                    [&](const spill_record& record) { run->write(record); });
+                merged.push_back(std::move(run));
+            }
+            runs = std::move(merged);
+        }
+        merge_runs(runs, 0, runs.size(), emit);
+    }
+    table.finish();
+}
+
+void simulator::run_incremental(event_policy policy, const std::string& fileName,
+    const std::string& stateFile, const sim_options& options)
+{
+    if (policy == event_policy::RR) {
+        throw std::runtime_error("ERROR : incremental : only fifo and sjf can be run incrementally");
+    }
+    // the state only keeps the totals, not how the times are spread out
+    if (options.percentiles) {
+        throw std::runtime_error("ERROR : incremental : percentiles can't be worked out incrementally");
+    }
+    if (workload_generator::is_spec(fileName) || loader::is_binary(fileName)) {
+        throw std::runtime_error("ERROR : incremental : only CSV traces can be added to");
+    }
+    std::string policyName = (policy == event_policy::FIFO) ? "fifo" : "sjf";
+
+    // pick up where the last run left off, or start from the top without one
+    incremental_state state;
+    if (state_file::load(stateFile, state) && state.policy != policyName) {
+        std::string error = "ERROR : incremental : state file \"" + stateFile + "\" is for " + 
+            state.policy + " not " + policyName;
+        throw std::runtime_error(error);
+    }
+    state.policy = policyName;
+
+    mapped_file file;
+    if (!file.map(fileName)) {
+        std::string error = "ERROR : loader : file \"" + fileName + "\" does not exist";
+        throw std::runtime_error(error);
+    }
+
+    // make sure what was simulated last time is still there
+    const char* begin = file.data();
+    const char* end = begin + file.size();
+    if (file.size() < state.offset || (state.offset > 0 && state.check != state_file::checksum(
+        begin + state.offset - std::min<std::size_t>(state.offset, STATE_CHECK_BYTES), begin + state.offset))) {
+        std::string error = "ERROR : incremental : trace \"" + fileName + 
+            "\" has changed, not just grown : remove \"" + stateFile + "\" to start again";
+        throw std::runtime_error(error);
+    }
+
+    // the last run took a line without its newline, so the line has to end here
+    // if it was carried on instead, the process already printed was only part of it
+    const char* first = begin + state.offset;
+    if (state.openLine && first != end) {
+        if (*first == '\r' && first + 1 != end) {
+            ++first;
+        }
+        if (*first != '\n') {
+            std::string error = "ERROR : incremental : the last line of trace \"" + fileName +
+                "\" was carried on after it was simulated : remove \"" + stateFile + "\" to start again";
+            throw std::runtime_error(error);
+        }
+        ++first;
+        state.openLine = false;
+    }
+
+    // whole lines are read first
+    const char* last = (first == end) ? nullptr :
+        static_cast<const char*>(memrchr(first, '\n', end - first));
+    last = (last == nullptr) ? first : last + 1;
+    process_table added;
+    std::size_t numLines = loader::parse_lines(first, last, added, state.numLines);
+
+    // a last line without its newline counts if it parses, like it does for a plain run,
+    // otherwise it might still be being written so it's left for next time
+    if (last != end) {
+        process_table tail;
+        try {
+            loader::parse_lines(last, end, tail, state.numLines + numLines);
+            added.append(tail);
+            ++numLines;
+            last = end;
+            state.openLine = true;
+        } catch (const std::runtime_error& e) {
+            std::cerr << "WARNING : incremental : left the last " << (end - last) <<
+                " bytes of \"" << fileName << "\" for next time, they aren't a whole line yet" << std::endl;
+        }
+    }
+
+    const std::vector<osp2023::id_type>& ids = added.getIds();
+    const std::vector<osp2023::time_type>& burstTimes = added.getBurstTimes();
+    const std::vector<osp2023::time_type>& arrivalTimes = added.getArrivalTimes();
+
+    // check the new processes before anything is printed
+    osp2023::time_type lastArrival = state.lastArrival;
+    for (std::size_t i = 0; i < added.size(); ++i) {
+        // an early arrival would have run before processes that were already simulated
+        if (policy == event_policy::FIFO && arrivalTimes[i] < lastArrival) {
+            std::string error = "ERROR : incremental : fifo needs the processes in arrival order : process " +
+                std::to_string(ids[i]) + " arrives before the one above it";
+            throw std::runtime_error(error);
+        }
+        if (policy == event_policy::SJF && arrivalTimes[i] != osp2023::time_zero) {
+            std::string error = "ERROR : incremental : sjf needs every process to arrive at 0 : process " +
+                std::to_string(ids[i]) + " arrives at " + std::to_string(arrivalTimes[i]);
+            throw std::runtime_error(error);
+        }
+        lastArrival = arrivalTimes[i];
+    }
+    state.hasArrivalTimes = state.hasArrivalTimes || added.hasArrivalTimes();
+    results_table table(*options.out, options.summary_only, state.hasArrivalTimes);
+
+    if (policy == event_policy::FIFO) {
+        // the new processes just queue up behind the old ones
+        for (std::size_t i = 0; i < added.size(); ++i) {
+            state.clock = std::max(state.clock, arrivalTimes[i]);
+            osp2023::time_type waitTime = state.clock - arrivalTimes[i];
+            state.clock += burstTimes[i];
+            table.add(ids[i], burstTimes[i], arrivalTimes[i], 
+                waitTime, waitTime + burstTimes[i], waitTime);
+            state.summary.add(waitTime, waitTime + burstTimes[i], waitTime);
+        }
+        state.lastArrival = lastArrival;
+    } else {
+        // the new processes go after the old ones with the same burst time, like they are in the file
+        for (std::size_t i = 0; i < added.size(); ++i) {
+            ++state.burstCounts[burstTimes[i]];
+        }
+
+        // every process after a new one waits longer now, so the totals are worked out
+        // again one burst time at a time, the processes with the same burst time run
+        // one after another so their waits add up to count * start + burst * (0 + 1 + ... + count - 1)
+        std::vector<std::size_t> order = radix_sort::order(burstTimes);
+        std::size_t next = 0;
+        osp2023::time_type start = osp2023::time_zero;
+        osp2023::time_type totalWait = osp2023::time_zero;
+        std::size_t numProcesses = 0;
+        for (const auto& [burstTime, count] : state.burstCounts) {
+            osp2023::time_type numSame = static_cast<osp2023::time_type>(count);
+            std::size_t numNew = 0;
+            while (next + numNew < order.size() && burstTimes[order[next + numNew]] == burstTime) {
+                ++numNew;
+            }
+            for (std::size_t j = 0; j < numNew; ++j) {
+                osp2023::time_type waitTime = start + 
+                    static_cast<osp2023::time_type>(count - numNew + j) * burstTime;
+                table.add(ids[order[next + j]], burstTime, osp2023::time_zero, 
+                    waitTime, waitTime + burstTime, waitTime);
+            }
+            next += numNew;
+
+            totalWait += numSame * start + burstTime * (numSame * (numSame - 1) / 2);
+            start += numSame * burstTime;
+            numProcesses += count;
+        }
+        // the last process finishes once every burst is done
+        state.summary = run_summary(numProcesses, totalWait, totalWait + start, totalWait);
+    }
+    table.finish(state.summary);
+
+    // remember how far through the trace we got
+    state.offset = last - begin;
+    state.numLines += numLines;
+    state.check = state_file::checksum(
+        last - std::min<std::size_t>(state.offset, STATE_CHECK_BYTES), last);
+    state_file::save(stateFile, state);
+}
+
+void simulator::run_multi(event_policy policy, osp2023::time_type quantum, std::size_t numCpus,
+    process_table processes, const sim_options& options)
+{
+    // check if quantum is not negative
+    if (policy == event_policy::RR && 
+        (quantum < pcb::MIN_DURATION || quantum > pcb::MAX_DURATION)) {
+        std::string error 
+            = "ERROR : simulator : run multi quantum must be between " + 
+            std::to_string(pcb::MIN_DURATION) + " and " + std::to_string(pcb::MAX_DURATION);
+            throw std::runtime_error(error);
+    }
+    if (numCpus < 1) {
+        std::string error = "ERROR : simulator : run multi needs at least 1 cpu";
+        throw std::runtime_error(error);
+    }
+
+    std::vector<core_stats> cores = schedule_multi(policy, quantum, numCpus, processes);
+    print_results(processes, options);
+    print_cores(cores, processes, options);
+}
+
+std::vector<core_stats> simulator::schedule_multi(event_policy policy, osp2023::time_type quantum,
+    std::size_t numCpus, process_table& processes)
+{
+    const std::vector<osp2023::time_type>& burstTimes = processes.getBurstTimes();
+    const std::vector<osp2023::time_type>& arrivalTimes = processes.getArrivalTimes();
+    std::vector<osp2023::time_type>& timesUsed = processes.getTimesUsed();
+    std::vector<osp2023::time_type>& waitTimes = processes.getWaitTimes();
+    std::vector<osp2023::time_type>& turnaroundTimes = processes.getTurnaroundTimes();
+    std::vector<osp2023::time_type>& responseTimes = processes.getResponseTimes();
+
+    // every process starts off as an arrival event
+    std::vector<sim_event> arrivals(processes.size());
+    for (std::size_t i = 0; i < processes.size(); ++i) {
+        arrivals[i] = {arrivalTimes[i], event_type::ARRIVAL, i};
+    }
+    event_queue events;
+    events.assign(std::move(arrivals));
+
+    // each cpu's run queue is ordered by (key, row), the front is the next to run
+    // sjf keys on burst time, fifo and rr on the order processes joined any queue
+    using run_queue = std::set<std::pair<osp2023::time_type, std::size_t>>;
+    std::vector<run_queue> queues(numCpus);
+    osp2023::time_type nextSequence = 0;
+    auto enqueue = [&](std::size_t cpu, std::size_t row) {
+        osp2023::time_type key = (policy == event_policy::SJF) ? burstTimes[row] : nextSequence++;
+        queues[cpu].insert({key, row});
+    };
+
+    std::vector<core_stats> cores(numCpus);
+    std::vector<bool> busy(numCpus, false);
+    // which cpu each process is running on, and for how long
+    std::vector<std::size_t> cpuOf(processes.size());
+    std::vector<osp2023::time_type> slices(processes.size(), osp2023::time_zero);
+    std::size_t nextDeal = 0;
+
+    while (!events.empty()) {
+        sim_event event = events.pop();
+        osp2023::time_type now = event.time;
+        std::size_t row = event.process;
+
+        switch (event.type) {
+            case event_type::ARRIVAL:
+                // deal arriving processes out to the cpus in turn
+                enqueue(nextDeal, row);
+                nextDeal = (nextDeal + 1) % numCpus;
+                break;
+
+            case event_type::COMPLETION:
+                timesUsed[row] += slices[row];
+                // turnaroundTime = completionTime - arrivalTime
+                turnaroundTimes[row] = now - arrivalTimes[row];
+                // waitTime = turnaroundTime - burstTime
+                waitTimes[row] = turnaroundTimes[row] - burstTimes[row];
+                busy[cpuOf[row]] = false;
+                break;
+
+            case event_type::QUANTUM_EXPIRY:
+                // back of the queue of the cpu it ran on
+                timesUsed[row] += slices[row];
+                enqueue(cpuOf[row], row);
+                busy[cpuOf[row]] = false;
+                break;
+        }
+
+        // only hand out work once everything at this time has happened
+        if (!events.empty() && events.top().time == now) {
+            continue;
+        }
+
+        // give every idle cpu something to do, in cpu order so runs are repeatable
+        for (std::size_t cpu = 0; cpu < numCpus; ++cpu) {
+            if (busy[cpu]) {
+                continue;
+            }
+
+            std::size_t next = 0;
+            if (!queues[cpu].empty()) {
+                next = queues[cpu].begin()->second;
+                queues[cpu].erase(queues[cpu].begin());
+            } else {
+                // steal from the back of the longest queue, the lowest cpu wins a tie
+                std::size_t victim = cpu;
+                for (std::size_t other = 0; other < numCpus; ++other) {
+                    if (queues[other].size() > queues[victim].size()) {
+                        victim = other;
+                    }
+                }
+                if (queues[victim].empty()) {
+                    // nothing anywhere, stay idle until something happens
+                    continue;
+                }
+                auto stolen = std::prev(queues[victim].end());
+                next = stolen->second;
+                queues[victim].erase(stolen);
+                ++cores[cpu].steals;
+            }
+
+            // responseTime = firstTime - arrivalTime
+            if (responseTimes[next] == osp2023::time_not_set) {
+                responseTimes[next] = now - arrivalTimes[next];
+            }
+
+            // fifo and sjf run the process to the end, rr gives it at most a quantum
+            osp2023::time_type remaining = burstTimes[next] - timesUsed[next];
+            osp2023::time_type slice = (policy == event_policy::RR) ? std::min(quantum, remaining) : remaining;
+            event_type outcome = (slice == remaining) ? 
+                event_type::COMPLETION : event_type::QUANTUM_EXPIRY;
+            events.push({now + slice, outcome, next});
+
+            cpuOf[next] = cpu;
+            slices[next] = slice;
+            busy[cpu] = true;
+            cores[cpu].busyTime += slice;
+            ++cores[cpu].dispatches;
+        }
+    }
+
+    return cores;
+}
+
+void simulator::print_cores(const std::vector<core_stats>& cores, const process_table& processes,
+    const sim_options& options)
+{
+    std::ostream& out = *options.out;
+
+    // the run lasts until the last process completes
+    osp2023::time_type makespan = osp2023::time_zero;
+    const std::vector<osp2023::time_type>& arrivalTimes = processes.getArrivalTimes();
+    const std::vector<osp2023::time_type>& turnaroundTimes = processes.getTurnaroundTimes();
+    for (std::size_t i = 0; i < processes.size(); ++i) {
+        makespan = std::max(makespan, arrivalTimes[i] + turnaroundTimes[i]);
+    }
+
+    // get the length of each column from the table header
+    std::size_t coreColLen = strlen(CORE_HEADER);
+    std::size_t busyTimeColLen = strlen(BUSY_TIME_HEADER);
+    std::size_t dispatchesColLen = strlen(DISPATCHES_HEADER);
+    std::size_t stealsColLen = strlen(STEALS_HEADER);
+    std::size_t utilisationColLen = strlen(UTILISATION_HEADER);
+    std::size_t rowLen = coreColLen + busyTimeColLen + dispatchesColLen + stealsColLen + 
+        utilisationColLen + NUM_CORE_TABLE_COL - 1;
+
+    out << '\n';
+    out << 
+        CORE_HEADER << TABLE_VERT_SEP <<
+        BUSY_TIME_HEADER << TABLE_VERT_SEP <<
+        DISPATCHES_HEADER << TABLE_VERT_SEP <<
+        STEALS_HEADER << TABLE_VERT_SEP <<
+        UTILISATION_HEADER << '\n';
+    out << std::string(rowLen, TABLE_HORZ_SEP) << '\n';
+
+    for (std::size_t cpu = 0; cpu < cores.size(); ++cpu) {
+        double utilisation = (makespan == 0) ? 0.0 : 100.0 * cores[cpu].busyTime / makespan;
+        out << 
+            std::setw(coreColLen) << std::left << cpu << TABLE_VERT_SEP <<
+            std::setw(busyTimeColLen) << std::left << cores[cpu].busyTime << TABLE_VERT_SEP <<
+            std::setw(dispatchesColLen) << std::left << cores[cpu].dispatches << TABLE_VERT_SEP <<
+            std::setw(stealsColLen) << std::left << cores[cpu].steals << TABLE_VERT_SEP <<
+            std::setw(utilisationColLen) << std::left << utilisation << '\n';
+    }
+
+    out << '\n';
+    out << MAKESPAN_TITLE << makespan << '\n';
+    out.flush();
+}
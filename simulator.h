@@ -7,42 +7,289 @@
 #include <string>
 #include <string.h>
 #include <algorithm>
-#include <deque>
+#include <queue>
+#include <set>
+#include <thread>
+#include <memory>
+#include <iostream>
 #include "pcb.h"
+#include "process_table.h"
 #include "types.h"
+#include "fenwick_tree.h"
+#include "run_summary.h"
+#include "buffered_writer.h"
+#include "thread_pool.h"
+#include "event_queue.h"
+#include "addressable_heap.h"
+#include "index_ring.h"
+#include "radix_sort.h"
+#include "policy.h"
+#include "policies.h"
+#include "mlfq_policy.h"
+#include "cfs_policy.h"
+#include "share_policies.h"
+#include "timeline.h"
+#include "stats_recorder.h"
+#include "results_table.h"
+#include "latency_histogram.h"
+#include "trace_stream.h"
+#include "spill_file.h"
+#include "state_file.h"
+#include "mapped_file.h"
 
-#define TABLE_VERT_SEP '|'
-#define TABLE_HORZ_SEP '-'
+#define CORE_HEADER " Core "
+#define BUSY_TIME_HEADER " Busy Time "
+#define DISPATCHES_HEADER " Dispatches "
+#define STEALS_HEADER " Steals "
+#define UTILISATION_HEADER " Utilisation (%) "
+#define NUM_CORE_TABLE_COL 5
+#define MAKESPAN_TITLE "Makespan = "
 
-#define PROCESS_ID_HEADER " Process ID "
-#define BURST_TIME_HEADER " Burst Time "
-#define WAIT_TIME_HEADER " Wait Time "
-#define TURNAROUND_TIME_HEADER " Turnaround Time "
-#define RESPONSE_TIME_HEADER " Response Time "
-#define NUM_TABLE_COL 5
+#define QUANTUM_HEADER " Quantum "
+#define AVG_WAIT_TIME_HEADER " Avg. Wait Time "
+#define AVG_TURNAROUND_TIME_HEADER " Avg. Turnaround Time "
+#define AVG_RESPONSE_TIME_HEADER " Avg. Response Time "
+#define NUM_SWEEP_TABLE_COL 4
 
-#define AVG_WAIT_TIME_TITLE "Avg. waiting time = "
-#define AVG_TURNAROUND_TIME_TITLE "Avg. turnaround time = "
-#define AVG_RESPONSE_TIME_TITLE "Avg. response time = " 
+#define BEST_WAIT_TIME_TITLE "Best quantum for waiting time = "
+#define BEST_TURNAROUND_TIME_TITLE "Best quantum for turnaround time = "
+#define BEST_RESPONSE_TIME_TITLE "Best quantum for response time = "
+
+// streaming sjf sorts this many processes in memory before spilling them
+#define STREAM_RUN_ROWS (1 << 22)
+// and merges at most this many spilled runs at once, so it never has too many files open
+#define STREAM_MERGE_WAYS 256
+
+// how the results of a simulation are written out
+struct sim_options {
+    // where the results go
+    std::ostream* out = &std::cout;
+    // only print the averages, not the per process table
+    bool summary_only = false;
+    // print the percentiles of the times after the averages
+    bool percentiles = false;
+};
+
+// the policies the discrete event core can run
+enum class event_policy {
+    FIFO,
+    SJF,
+    RR
+};
+
+// what one simulated cpu did over a multi cpu run
+struct core_stats {
+    osp2023::time_type busyTime = osp2023::time_zero;
+    // how many times a process was put on this cpu
+    std::size_t dispatches = 0;
+    // how many of those processes were taken from another cpu's queue
+    std::size_t steals = 0;
+};
+
+// the averages for one quantum of a round robin sweep
+struct sweep_result {
+    osp2023::time_type quantum;
+    run_summary summary;
+    // only filled in when the sweep is asked for percentiles, the histograms
+    // themselves are too big to keep for every quantum
+    latency_histogram::report_type waitPercentiles = {};
+    latency_histogram::report_type turnaroundPercentiles = {};
+    latency_histogram::report_type responsePercentiles = {};
+};
 
 class simulator
 {
     private:
-        static void print_results(const std::vector<pcb>& processes);
+        // the order the processes arrive in, by arrival time and then file order
+        static std::vector<std::size_t> arrival_order(const process_table& processes);
+        // merge the sorted runs [first, last) handing each record to emit in order,
+        // the runs are closed once they are used up
+        template <typename Emit>
+        static void merge_runs(std::vector<std::unique_ptr<spill_file>>& runs, 
+            std::size_t first, std::size_t last, Emit emit);
     public:
+        // the wait, turnaround and response totals of a simulated table in one pass
+        static run_summary summarise(const process_table& processes);
+        // print the per process table (unless summary only) and the averages
+        static void print_results(const process_table& processes, const sim_options& options);
+        // histograms of the times of a simulated table, big tables are split into
+        // blocks that are counted on every core and then merged, unless this is
+        // already one of a pool's workers
+        static latency_histograms latencies(const process_table& processes);
+
+        // run any scheduling_policy (see policy.h) and print its results
+        template <scheduling_policy Policy>
+        static void run(Policy policy, process_table processes,
+            const sim_options& options = sim_options())
+        {
+            simulate(policy, processes);
+            print_results(processes, options);
+        }
+        // the same, telling the recorder about every slice of cpu time handed out
+        template <scheduling_policy Policy, dispatch_recorder Recorder>
+        static void run(Policy policy, process_table processes,
+            const sim_options& options, Recorder& recorder)
+        {
+            simulate(policy, processes, recorder);
+            print_results(processes, options);
+        }
+
+        // run with --stats, the prepare and schedule phases time what a plain run
+        // of timed does, batch kernels and all, then the scheduler counts come
+        // from stepping counted over a copy of the processes, outside of any phase
+        template <scheduling_policy Policy>
+        static void run_stats(Policy timed, Policy counted, process_table processes,
+            const sim_options& options, stats_recorder& stats)
+        {
+            run_stats(std::move(counted), std::move(processes), options, stats,
+                [&stats, &timed](process_table& table) {
+                    stats_phases phases(stats);
+                    simulate(timed, table, phases);
+                });
+        }
+        // the same, for when a plain run schedules the processes some other way,
+        // eg. on the event core, schedule starts the schedule phase itself
+        template <scheduling_policy Policy, typename Schedule>
+        static void run_stats(Policy policy, process_table processes,
+            const sim_options& options, stats_recorder& stats, Schedule schedule)
+        {
+            process_table counted = processes;
+            stats.begin_phase(STATS_PHASE_PREPARE);
+            schedule(processes);
+            stats.end_phase();
+
+            simulate(policy, counted, stats);
+
+            stats.begin_phase(STATS_PHASE_PRINT);
+            print_results(processes, options);
+            stats.end_phase();
+        }
+
         // implemented both vector and queue cpu scheduling algorithms
 
-        // make sure we're copying the original pcb vector so we don't modify the original
-        static void run_fifo(std::vector<pcb> processes);
-        static void run_sjf(std::vector<pcb> processes);
-        static void run_rr(osp2023::time_type quantum, std::vector<pcb> processes);
+        // make sure we're copying the original process table so we don't modify the original
+        static void run_fifo(process_table processes,
+            const sim_options& options = sim_options());
+        static void run_sjf(process_table processes,
+            const sim_options& options = sim_options());
+        static void run_rr(osp2023::time_type quantum, process_table processes,
+            const sim_options& options = sim_options());
+
+        // fill in the times without printing them, for timing the scheduling on its own
+        // schedule_fifo splits large tables into blocks that are scanned on every core
+        // the sjf ones also put the table into sjf order
+        static void schedule_fifo(process_table& processes);
+        static void schedule_sjf(process_table& processes);
+        static void schedule_rr(osp2023::time_type quantum, process_table& processes);
 
         // now the same implementations but using a queue instead
-        // still passing a vector, so i can still use the same print function
+        // still passing a table, so i can still use the same print function
         // and can still sort
-        static void run_fifo_queue(std::vector<pcb> processes);
-        static void run_sjf_queue(std::vector<pcb> processes);
-        static void run_rr_queue(osp2023::time_type quantum, std::vector<pcb> processes);
+        static void run_fifo_queue(process_table processes,
+            const sim_options& options = sim_options());
+        static void run_sjf_queue(process_table processes,
+            const sim_options& options = sim_options());
+        static void run_rr_queue(osp2023::time_type quantum, process_table processes,
+            const sim_options& options = sim_options());
+        static void schedule_fifo_queue(process_table& processes);
+        static void schedule_sjf_queue(process_table& processes);
+        static void schedule_rr_queue(osp2023::time_type quantum, process_table& processes);
+
+        // round robin again, but skipping whole rounds in closed form
+        // instead of stepping quantum by quantum, runs in O(n log n)
+        // throws if any process arrives after 0
+        static void run_rr_rounds(osp2023::time_type quantum, process_table processes,
+            const sim_options& options = sim_options());
+        // fill in the times run_rr_rounds would without printing them
+        static void schedule_rr_rounds(osp2023::time_type quantum, process_table& processes);
+
+        // simulate round robin for every quantum from minQuantum to maxQuantum concurrently
+        // each quantum runs on its own copy of the processes
+        // withPercentiles works out the percentiles of each quantum's times as well
+        static std::vector<sweep_result> sweep_rr(const process_table& processes,
+            osp2023::time_type minQuantum, osp2023::time_type maxQuantum,
+            bool withPercentiles = false);
+        // the same policies again on a discrete event core that handles arrival times
+        // it jumps straight from one arrival, completion or quantum expiry to the next
+        static void run_fifo_events(process_table processes,
+            const sim_options& options = sim_options());
+        static void run_sjf_events(process_table processes,
+            const sim_options& options = sim_options());
+        static void run_rr_events(osp2023::time_type quantum, process_table processes,
+            const sim_options& options = sim_options());
+        // fill in the times for a policy on the event core without printing them
+        // the quantum is only used by rr
+        static void schedule_events(event_policy policy, osp2023::time_type quantum, 
+            process_table& processes);
+
+        // preemptive shortest remaining time first, ties go to the process first in the file
+        // and a process is only preempted by one with strictly less time left
+        static void run_srtf(process_table processes,
+            const sim_options& options = sim_options());
+        static void schedule_srtf(process_table& processes);
+
+        // multi-level feedback queue with numLevels levels, the quantum is for the top
+        // level and doubles on each level down, everything is boosted back to the top
+        // level every boostPeriod (0 never boosts), handles arrival times
+        static void run_mlfq(osp2023::time_type quantum, std::size_t numLevels, 
+            osp2023::time_type boostPeriod, process_table processes,
+            const sim_options& options = sim_options());
+        static void schedule_mlfq(osp2023::time_type quantum, std::size_t numLevels, 
+            osp2023::time_type boostPeriod, process_table& processes);
+
+        // completely fair scheduling on each process's weight, every runnable process
+        // runs within targetLatency but never for less than minGranularity at a time
+        static void run_cfs(osp2023::time_type targetLatency, osp2023::time_type minGranularity,
+            process_table processes, const sim_options& options = sim_options());
+        static void schedule_cfs(osp2023::time_type targetLatency, osp2023::time_type minGranularity,
+            process_table& processes);
+
+        // proportional share with each process's weight as its tickets, up to a quantum at a time
+        // lottery draws the next process at random from seed, stride picks the one
+        // with the lowest pass so it gives the same shares without the randomness
+        static void run_lottery(osp2023::time_type quantum, std::uint64_t seed, 
+            process_table processes, const sim_options& options = sim_options());
+        static void schedule_lottery(osp2023::time_type quantum, std::uint64_t seed, 
+            process_table& processes);
+        static void run_stride(osp2023::time_type quantum, process_table processes, 
+            const sim_options& options = sim_options());
+        static void schedule_stride(osp2023::time_type quantum, process_table& processes);
+
+        // simulate straight from the file without loading the whole trace, the results
+        // are the same as run_fifo and run_sjf but the memory used doesn't grow with the trace
+        // fifo keeps just the clock, so the processes have to be in arrival order
+        // sjf sorts the burst times in runs that are spilled to temp files and merged
+        // back together, so every process has to arrive at 0
+        static void stream_fifo(const std::string& fileName, 
+            const sim_options& options = sim_options());
+        static void stream_sjf(const std::string& fileName, 
+            const sim_options& options = sim_options());
+
+        // carry on a fifo or sjf run from the state saved in stateFile by the last one,
+        // only the lines added to the end of the trace since then are read. the new
+        // processes are printed with the averages over the whole trace so far, with sjf
+        // the old processes the new ones go in front of wait longer too but only the
+        // averages show it, the old rows aren't kept so they can't be printed again
+        // fifo needs the new processes to arrive in order after the old ones, sjf needs
+        // every process to arrive at 0 and costs O(distinct burst times) as well
+        static void run_incremental(event_policy policy, const std::string& fileName,
+            const std::string& stateFile, const sim_options& options = sim_options());
+
+        // fifo, sjf or rr on numCpus cpus, each with its own run queue
+        // arriving processes are dealt to the cpus in turn and a cpu with nothing
+        // left to run steals from the back of the longest queue
+        static void run_multi(event_policy policy, osp2023::time_type quantum, std::size_t numCpus,
+            process_table processes, const sim_options& options = sim_options());
+        // fill in the times without printing them, returns what each cpu did
+        static std::vector<core_stats> schedule_multi(event_policy policy, osp2023::time_type quantum,
+            std::size_t numCpus, process_table& processes);
+        // print the busy time and utilisation of each cpu
+        static void print_cores(const std::vector<core_stats>& cores, const process_table& processes,
+            const sim_options& options = sim_options());
+
+        // print the averages for each quantum and the best quantum for each of them
+        static void print_sweep(const std::vector<sweep_result>& results,
+            const sim_options& options = sim_options());
 };
 
 #endif
\ No newline at end of file
@@ -1,39 +1,154 @@
 #include <iostream>
 #include <vector>
+#include <optional>
 
 #include "loader.h"
 #include "pcb.h"
+#include "process_table.h"
 #include "types.h"
 #include "simulator.h"
+#include "cmd_options.h"
+#include "stats_recorder.h"
 
-#define NUM_CMD_ARGS 2
-#define FILE_NAME_INDEX 1
+// positions of the plain args, not counting the program name or options
+#define NUM_CMD_ARGS 1
+#define FILE_NAME_INDEX 0
+
+#define SUMMARY_ONLY_OPTION "--summary-only"
+#define PERCENTILES_OPTION "--percentiles"
+#define CPUS_OPTION "--cpus"
+#define TIMELINE_OPTION "--timeline"
+#define STATS_OPTION "--stats"
+#define STREAM_OPTION "--stream"
+#define INCREMENTAL_OPTION "--incremental"
 
 int main(int argc, char** argv)
 {
+    // split the options from the plain args
+    // if there is an unknown option exit the program
+    cmd_options cmd({SUMMARY_ONLY_OPTION, PERCENTILES_OPTION, STATS_OPTION, STREAM_OPTION}, {CPUS_OPTION, TIMELINE_OPTION, INCREMENTAL_OPTION});
+    try {
+        cmd.parse(argc, argv);
+    } catch (const std::runtime_error& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
     // check if the number of cmd arguments is correct
     // if it doesn't exit the program
-    if (argc != NUM_CMD_ARGS) {
-        std::string error = "ERROR : incorrect numnber of args : should be ./sjf <datafile>";
+    if (cmd.positional().size() != NUM_CMD_ARGS) {
+        std::string error = "ERROR : incorrect numnber of args : should be ./sjf [--summary-only] [--percentiles] [--cpus <n> | --timeline <file> | --stats | --stream | --incremental <statefile>] <datafile>";
+        std::cout << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // try to parse the number of cpus, one unless asked for more
+    std::size_t numCpus = 1;
+    if (cmd.has(CPUS_OPTION)) {
+        long long cpusArg = 0;
+        try {
+            cpusArg = std::stoll(cmd.value(CPUS_OPTION));
+        } catch (const std::exception& e) {
+            std::string error = "ERROR : unable to parse cpus cmd arg";
+            std::cout << error << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (cpusArg < 1) {
+            std::string error = "ERROR : cpus must be at least 1";
+            std::cout << error << std::endl;
+            return EXIT_FAILURE;
+        }
+        numCpus = static_cast<std::size_t>(cpusArg);
+    }
+
+    // only one of the ways of running can be picked
+    if (cmd.has(CPUS_OPTION) + cmd.has(TIMELINE_OPTION) + cmd.has(STATS_OPTION) + 
+        cmd.has(STREAM_OPTION) + cmd.has(INCREMENTAL_OPTION) > 1) {
+        std::string error = "ERROR : only one of --cpus, --timeline, --stats, --stream and --incremental can be used";
         std::cout << error << std::endl;
         return EXIT_FAILURE;
     }
 
     // get the file name from cmd args
-    std::string fileName = argv[FILE_NAME_INDEX];
+    std::string fileName = cmd.positional().at(FILE_NAME_INDEX);
+
+    // set up how the results are printed
+    sim_options options;
+    options.summary_only = cmd.has(SUMMARY_ONLY_OPTION);
+    options.percentiles = cmd.has(PERCENTILES_OPTION);
 
-    std::vector<pcb> processes;
+    // streaming reads the trace as it goes instead of loading it first
+    if (cmd.has(STREAM_OPTION)) {
+        try {
+            simulator::stream_sjf(fileName, options);
+        } catch (const std::exception& e) {
+            std::cout << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // incremental runs only read what was added to the trace since the last one
+    if (cmd.has(INCREMENTAL_OPTION)) {
+        try {
+            simulator::run_incremental(event_policy::SJF, fileName, cmd.value(INCREMENTAL_OPTION), options);
+        } catch (const std::exception& e) {
+            std::cout << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+    
+    // the stats time everything from the load onwards
+    std::optional<stats_recorder> stats;
+    if (cmd.has(STATS_OPTION)) {
+        stats.emplace();
+        stats->begin_phase(STATS_PHASE_LOAD);
+    }
+
+    process_table processes;
     try{
-        //try to load the processes CSV file
-        processes = loader::load_csv(fileName);
+        // try to load the processes CSV file or binary trace
+        processes = loader::load(fileName);
     } catch(const std::exception& e) {
         std::cout << e.what() << std::endl;
         return EXIT_FAILURE;
     }
 
     // start the simulation
-    simulator::run_sjf(processes);
-
+    // the event core handles processes that don't all arrive at 0
+    // more than one cpu gives each its own run queue
+    if (cmd.has(CPUS_OPTION)) {
+        simulator::run_multi(event_policy::SJF, osp2023::time_zero, numCpus, processes, options);
+    } else if (cmd.has(TIMELINE_OPTION)) {
+        // record every slice handed out and save it when the run is done
+        timeline_recorder timeline;
+        simulator::run(sjf_policy(), processes, options, timeline);
+        try {
+            timeline.save(cmd.value(TIMELINE_OPTION));
+        } catch (const std::runtime_error& e) {
+            std::cout << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    } else if (stats) {
+        // timed on the same path as a plain run, the event core when processes
+        // arrive late, and counted with the same policy as the timeline
+        if (processes.hasArrivalTimes()) {
+            simulator::run_stats(sjf_policy(), processes, options, *stats, [&stats](process_table& table) {
+                stats->begin_phase(STATS_PHASE_SCHEDULE);
+                simulator::schedule_events(event_policy::SJF, osp2023::time_not_set, table);
+            });
+        } else {
+            simulator::run_stats(sjf_policy(), sjf_policy(), processes, options, *stats);
+        }
+        // the stats go to stderr so the results on stdout stay the same
+        stats->write_json(std::cerr, "sjf", osp2023::time_not_set, processes.size());
+    } else if (processes.hasArrivalTimes()) {
+        simulator::run_sjf_events(processes, options);
+    } else {
+        simulator::run_sjf(processes, options);
+    }
+    
     //exit main
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
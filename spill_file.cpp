@@ -0,0 +1,106 @@
+#include "spill_file.h"
+
+#include <cstdlib>
+#include <cerrno>
+#include <stdexcept>
+#include <unistd.h>
+
+spill_file::spill_file():
+    fd(-1), buffer(SPILL_BUFFER_RECORDS), position(0), numBuffered(0), writing(true), numRecords(0)
+{
+    const char* dir = getenv("TMPDIR");
+    std::string path = std::string((dir == nullptr || *dir == '\0') ? SPILL_DEFAULT_DIR : dir) +
+        "/" SPILL_FILE_TEMPLATE;
+
+    // mkstemp fills in the X's in place
+    std::vector<char> name(path.begin(), path.end());
+    name.push_back('\0');
+    fd = mkstemp(name.data());
+    if (fd < 0) {
+        std::string error = "ERROR : spill : unable to make a temp file \"" + path + "\"";
+        throw std::runtime_error(error);
+    }
+    // nothing else needs the name, the file lives until it's closed
+    unlink(name.data());
+}
+
+spill_file::~spill_file()
+{
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+void spill_file::flush()
+{
+    const char* bytes = reinterpret_cast<const char*>(buffer.data());
+    std::size_t remaining = numBuffered * sizeof(spill_record);
+    while (remaining > 0) {
+        ssize_t numWritten = ::write(fd, bytes, remaining);
+        if (numWritten < 0 && errno == EINTR) {
+            continue;
+        }
+        if (numWritten <= 0) {
+            throw std::runtime_error("ERROR : spill : unable to write to the temp file");
+        }
+        bytes += numWritten;
+        remaining -= numWritten;
+    }
+    numBuffered = 0;
+}
+
+void spill_file::write(const spill_record& record)
+{
+    buffer[numBuffered++] = record;
+    ++numRecords;
+    if (numBuffered == buffer.size()) {
+        flush();
+    }
+}
+
+void spill_file::rewind()
+{
+    if (writing) {
+        flush();
+        writing = false;
+    }
+    if (lseek(fd, 0, SEEK_SET) != 0) {
+        throw std::runtime_error("ERROR : spill : unable to rewind the temp file");
+    }
+    position = 0;
+    numBuffered = 0;
+}
+
+bool spill_file::read(spill_record& record)
+{
+    if (position == numBuffered) {
+        // refill the buffer, the file only ever holds whole records
+        char* bytes = reinterpret_cast<char*>(buffer.data());
+        std::size_t numBytes = 0;
+        while (numBytes < buffer.size() * sizeof(spill_record)) {
+            ssize_t numRead = ::read(fd, bytes + numBytes, buffer.size() * sizeof(spill_record) - numBytes);
+            if (numRead < 0 && errno == EINTR) {
+                continue;
+            }
+            if (numRead < 0) {
+                throw std::runtime_error("ERROR : spill : unable to read the temp file");
+            }
+            if (numRead == 0) {
+                break;
+            }
+            numBytes += numRead;
+        }
+        position = 0;
+        numBuffered = numBytes / sizeof(spill_record);
+        if (numBuffered == 0) {
+            return false;
+        }
+    }
+    record = buffer[position++];
+    return true;
+}
+
+std::size_t spill_file::size() const
+{
+    return numRecords;
+}
@@ -0,0 +1,57 @@
+#ifndef SPILL_FILE_H
+#define SPILL_FILE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "types.h"
+
+// records are written and read back this many at a time
+#define SPILL_BUFFER_RECORDS (1 << 14)
+// the temp files go in $TMPDIR, or here if it isn't set
+#define SPILL_DEFAULT_DIR "/tmp"
+#define SPILL_FILE_TEMPLATE "osp_spill_XXXXXX"
+
+// one process in a sorted run, the key it is sorted on and its id
+struct spill_record {
+    osp2023::time_type key;
+    osp2023::id_type id;
+};
+
+/**
+ * an anonymous temp file of spill_records for an external sort. it is
+ * unlinked as soon as it is made, so it goes away when it is closed even
+ * if the program doesn't finish. records are written one after another,
+ * then the file is rewound and they are read back in the same order.
+ **/
+class spill_file
+{
+    private:
+        int fd;
+        std::vector<spill_record> buffer;
+        // the next record to read from the buffer, and how many are in it
+        std::size_t position;
+        std::size_t numBuffered;
+        bool writing;
+        std::size_t numRecords;
+
+        void flush();
+    public:
+        // make the temp file, throws if it can't be made
+        spill_file();
+        ~spill_file();
+
+        // the file belongs to this object so it can't be copied
+        spill_file(const spill_file& other) = delete;
+        spill_file& operator=(const spill_file& other) = delete;
+
+        void write(const spill_record& record);
+        // finish writing and go back to the start to read the records
+        void rewind();
+        // the next record, false once they have all been read
+        bool read(spill_record& record);
+
+        std::size_t size() const;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <vector>
+
+#include "loader.h"
+#include "pcb.h"
+#include "process_table.h"
+#include "types.h"
+#include "simulator.h"
+#include "cmd_options.h"
+
+// positions of the plain args, not counting the program name or options
+#define NUM_CMD_ARGS 1
+#define FILE_NAME_INDEX 0
+
+#define SUMMARY_ONLY_OPTION "--summary-only"
+#define PERCENTILES_OPTION "--percentiles"
+
+int main(int argc, char** argv)
+{
+    // split the options from the plain args
+    // if there is an unknown option exit the program
+    cmd_options cmd({SUMMARY_ONLY_OPTION, PERCENTILES_OPTION});
+    try {
+        cmd.parse(argc, argv);
+    } catch (const std::runtime_error& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // check if the number of cmd arguments is correct
+    // if it doesn't exit the program
+    if (cmd.positional().size() != NUM_CMD_ARGS) {
+        std::string error = "ERROR : incorrect numnber of args : should be ./srtf [--summary-only] [--percentiles] <datafile>";
+        std::cout << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // get the file name from cmd args
+    std::string fileName = cmd.positional().at(FILE_NAME_INDEX);
+    
+    process_table processes;
+    try{
+        // try to load the processes CSV file or binary trace
+        processes = loader::load(fileName);
+    } catch(const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // set up how the results are printed
+    sim_options options;
+    options.summary_only = cmd.has(SUMMARY_ONLY_OPTION);
+    options.percentiles = cmd.has(PERCENTILES_OPTION);
+
+    // start the simulation
+    simulator::run_srtf(processes, options);
+    
+    //exit main
+    return EXIT_SUCCESS;
+}
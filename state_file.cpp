@@ -0,0 +1,123 @@
+#include "state_file.h"
+
+#include <fstream>
+#include <cstdio>
+#include <stdexcept>
+
+bool state_file::load(const std::string& fileName, incremental_state& state)
+{
+    std::ifstream file(fileName);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string error = "ERROR : state : file \"" + fileName + "\" is not a state file";
+
+    // every value is on its own line after its name
+    auto expect = [&](const char* name) {
+        std::string key;
+        if (!(file >> key) || key != name) {
+            throw std::runtime_error(error);
+        }
+    };
+
+    std::string magic;
+    unsigned int version = 0;
+    if (!(file >> magic >> version) || magic != STATE_MAGIC) {
+        throw std::runtime_error(error);
+    }
+    if (version != STATE_VERSION) {
+        throw std::runtime_error("ERROR : state : state version " + std::to_string(version) +
+            " is not supported : in file \"" + fileName + "\"");
+    }
+
+    std::size_t numProcesses = 0;
+    osp2023::time_type totalWait = 0;
+    osp2023::time_type totalTurnaround = 0;
+    osp2023::time_type totalResponse = 0;
+    std::size_t numBursts = 0;
+    expect("policy");
+    file >> state.policy;
+    expect("offset");
+    file >> state.offset;
+    expect("open_line");
+    file >> state.openLine;
+    expect("lines");
+    file >> state.numLines;
+    expect("check");
+    file >> state.check;
+    expect("arrivals");
+    file >> state.hasArrivalTimes;
+    expect("clock");
+    file >> state.clock;
+    expect("last_arrival");
+    file >> state.lastArrival;
+    expect("processes");
+    file >> numProcesses;
+    expect("wait");
+    file >> totalWait;
+    expect("turnaround");
+    file >> totalTurnaround;
+    expect("response");
+    file >> totalResponse;
+    expect("bursts");
+    file >> numBursts;
+    state.summary = run_summary(numProcesses, totalWait, totalTurnaround, totalResponse);
+
+    state.burstCounts.clear();
+    for (std::size_t i = 0; i < numBursts && file; ++i) {
+        osp2023::time_type burstTime = 0;
+        std::size_t count = 0;
+        file >> burstTime >> count;
+        state.burstCounts[burstTime] = count;
+    }
+
+    if (!file) {
+        throw std::runtime_error(error);
+    }
+    return true;
+}
+
+void state_file::save(const std::string& fileName, const incremental_state& state)
+{
+    std::string newFileName = fileName + ".new";
+    std::ofstream file(newFileName, std::ofstream::out | std::ofstream::trunc);
+    if (!file.is_open()) {
+        std::string error = "ERROR : state : unable to write \"" + newFileName + "\"";
+        throw std::runtime_error(error);
+    }
+
+    file << STATE_MAGIC << ' ' << STATE_VERSION << '\n';
+    file << "policy " << state.policy << '\n';
+    file << "offset " << state.offset << '\n';
+    file << "open_line " << state.openLine << '\n';
+    file << "lines " << state.numLines << '\n';
+    file << "check " << state.check << '\n';
+    file << "arrivals " << state.hasArrivalTimes << '\n';
+    file << "clock " << state.clock << '\n';
+    file << "last_arrival " << state.lastArrival << '\n';
+    file << "processes " << state.summary.size() << '\n';
+    file << "wait " << state.summary.getTotalWait() << '\n';
+    file << "turnaround " << state.summary.getTotalTurnaround() << '\n';
+    file << "response " << state.summary.getTotalResponse() << '\n';
+    file << "bursts " << state.burstCounts.size() << '\n';
+    for (const auto& [burstTime, count] : state.burstCounts) {
+        file << burstTime << ' ' << count << '\n';
+    }
+    file.close();
+
+    if (!file || std::rename(newFileName.c_str(), fileName.c_str()) != 0) {
+        std::string error = "ERROR : state : unable to write \"" + fileName + "\"";
+        throw std::runtime_error(error);
+    }
+}
+
+std::uint64_t state_file::checksum(const char* first, const char* last)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (; first != last; ++first) {
+        hash ^= static_cast<unsigned char>(*first);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
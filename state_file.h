@@ -0,0 +1,59 @@
+#ifndef STATE_FILE_H
+#define STATE_FILE_H
+
+#include <string>
+#include <map>
+#include <cstddef>
+#include <cstdint>
+#include "types.h"
+#include "run_summary.h"
+
+#define STATE_MAGIC "osp-state"
+#define STATE_VERSION 2
+// the last this many bytes already simulated are checked each time, so a
+// trace that was rewritten instead of appended to is noticed
+#define STATE_CHECK_BYTES 4096
+
+// everything an incremental run needs to carry on from where the last one stopped
+struct incremental_state {
+    // the policy the state belongs to
+    std::string policy;
+    // how much of the trace has been simulated, always the end of a line
+    // or the end of the file when its last line had no newline (openLine)
+    std::size_t offset = 0;
+    bool openLine = false;
+    std::size_t numLines = 0;
+    // the hash of the STATE_CHECK_BYTES before offset
+    std::uint64_t check = 0;
+    bool hasArrivalTimes = false;
+
+    // fifo only needs to know when the cpu is free again and the totals so far
+    osp2023::time_type clock = osp2023::time_zero;
+    osp2023::time_type lastArrival = osp2023::time_zero;
+    run_summary summary;
+
+    // sjf only needs how many processes there are of each burst time, the
+    // totals can be worked out from that in one walk over the burst times
+    std::map<osp2023::time_type, std::size_t> burstCounts;
+};
+
+/**
+ * reads and writes the state of an incremental run as a small text file,
+ * one value per line after a magic line and version.
+ **/
+class state_file
+{
+    public:
+        // read the state back, false if the file doesn't exist yet
+        // throws if it exists but isn't a state file
+        static bool load(const std::string& fileName, incremental_state& state);
+
+        // write the state out, a new file is renamed over the old one so
+        // a run that dies half way through never leaves a broken state behind
+        static void save(const std::string& fileName, const incremental_state& state);
+
+        // a 64 bit FNV-1a hash of the bytes in [first, last)
+        static std::uint64_t checksum(const char* first, const char* last);
+};
+
+#endif
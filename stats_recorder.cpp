@@ -0,0 +1,89 @@
+#include "stats_recorder.h"
+#include "json.h"
+
+#include <algorithm>
+
+stats_recorder::stats_recorder():
+    inPhase(false), phaseCountersStart(), dispatches(0), preemptions(0), completions(0),
+    contextSwitches(0), queuePushes(0), queuePops(0), lastProcess(0), rounds(0) {};
+
+void stats_recorder::begin_phase(const std::string& name)
+{
+    end_phase();
+    inPhase = true;
+    phaseName = name;
+    phaseCountersStart = hardware.read();
+    phaseStart = std::chrono::steady_clock::now();
+}
+
+void stats_recorder::end_phase()
+{
+    if (!inPhase) {
+        return;
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::array<std::uint64_t, NUM_PERF_COUNTERS> countersEnd = hardware.read();
+
+    phase_stats phase;
+    phase.name = phaseName;
+    phase.wallNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - phaseStart).count();
+    for (std::size_t i = 0; i < NUM_PERF_COUNTERS; ++i) {
+        phase.counters[i] = countersEnd[i] - phaseCountersStart[i];
+    }
+    phases.push_back(phase);
+    inPhase = false;
+}
+
+void stats_recorder::prepared(const process_table& processes)
+{
+    // this is the counting run, so it doesn't start a phase
+    slicesPerRow.assign(processes.size(), 0);
+}
+
+void stats_recorder::write_json(std::ostream& out, const std::string& policy,
+    osp2023::time_type quantum, std::size_t numProcesses) const
+{
+    out << "{\"policy\":" << json::quote(policy);
+    out << ",\"quantum\":";
+    if (quantum == osp2023::time_not_set) {
+        out << "null";
+    } else {
+        out << quantum;
+    }
+    out << ",\"processes\":" << numProcesses;
+
+    out << ",\"phases\":[";
+    for (std::size_t i = 0; i < phases.size(); ++i) {
+        const phase_stats& phase = phases[i];
+        out << (i == 0 ? "" : ",");
+        out << "{\"name\":" << json::quote(phase.name) << ",\"wall_ns\":" << phase.wallNs;
+        for (std::size_t counter = 0; counter < NUM_PERF_COUNTERS; ++counter) {
+            perf_event event = static_cast<perf_event>(counter);
+            out << ",\"" << perf_counters::name(event) << "\":";
+            if (hardware.available(event)) {
+                out << phase.counters[counter];
+            } else {
+                out << "null";
+            }
+        }
+        out << "}";
+    }
+    out << "]";
+
+    out << ",\"counters\":{";
+    out << "\"dispatches\":" << dispatches;
+    out << ",\"context_switches\":" << contextSwitches;
+    out << ",\"preemptions\":" << preemptions;
+    out << ",\"completions\":" << completions;
+    out << ",\"queue_pushes\":" << queuePushes;
+    out << ",\"queue_pops\":" << queuePops;
+    out << ",\"rounds\":" << rounds;
+    out << "}";
+
+    out << ",\"hardware_counters\":" << (hardware.any_available() ? "true" : "false");
+    if (!hardware.unavailable_reason().empty()) {
+        // the reason can be strerror text or a path, so it has to be escaped
+        out << ",\"hardware_counters_error\":" << json::quote(hardware.unavailable_reason());
+    }
+    out << "}" << std::endl;
+}
@@ -0,0 +1,118 @@
+#ifndef STATS_RECORDER_H
+#define STATS_RECORDER_H
+
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <string>
+#include <chrono>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+#include "types.h"
+#include "process_table.h"
+#include "perf_counters.h"
+
+// the phases of a run, prepare is the sorting a policy does before the loop
+#define STATS_PHASE_LOAD "load"
+#define STATS_PHASE_PREPARE "prepare"
+#define STATS_PHASE_SCHEDULE "schedule"
+#define STATS_PHASE_PRINT "print"
+
+// the wall time and hardware counts of one phase
+struct phase_stats {
+    std::string name;
+    std::int64_t wallNs;
+    std::array<std::uint64_t, NUM_PERF_COUNTERS> counters;
+};
+
+/**
+ * times each phase of a run and counts what the scheduler did, then writes it
+ * all out as json. the phases are timed on the same path a plain run takes
+ * (see stats_phases below), the counts come from it being the dispatch_recorder
+ * of a separate stepwise run that isn't timed.
+ **/
+class stats_recorder
+{
+    private:
+        perf_counters hardware;
+        std::vector<phase_stats> phases;
+
+        bool inPhase;
+        std::string phaseName;
+        std::chrono::steady_clock::time_point phaseStart;
+        std::array<std::uint64_t, NUM_PERF_COUNTERS> phaseCountersStart;
+
+        // slices handed out, and how each one ended
+        std::uint64_t dispatches;
+        std::uint64_t preemptions;
+        std::uint64_t completions;
+        // dispatches of a different process to the one that ran last
+        std::uint64_t contextSwitches;
+        // a row goes onto the ready queue when it arrives and again whenever
+        // it's preempted, and comes off it for every slice
+        std::uint64_t queuePushes;
+        std::uint64_t queuePops;
+        osp2023::id_type lastProcess;
+        // slices each row has had, the most any row had is the number of rounds
+        std::vector<std::uint32_t> slicesPerRow;
+        std::uint32_t rounds;
+    public:
+        static constexpr bool enabled = true;
+
+        stats_recorder();
+
+        // end the current phase (if any) and start timing the next one
+        void begin_phase(const std::string& name);
+        void end_phase();
+
+        void prepared(const process_table& processes);
+
+        void record(std::size_t row, osp2023::id_type process, osp2023::time_type,
+            osp2023::time_type, bool finished)
+        {
+            if (dispatches > 0 && process != lastProcess) {
+                ++contextSwitches;
+            }
+            lastProcess = process;
+            ++dispatches;
+            // its first slice is when it came off the queue it was pushed onto on arrival
+            if (slicesPerRow[row] == 0) {
+                ++queuePushes;
+            }
+            ++queuePops;
+            if (finished) {
+                ++completions;
+            } else {
+                ++preemptions;
+                ++queuePushes;
+            }
+            rounds = std::max(rounds, ++slicesPerRow[row]);
+        }
+
+        // the stats as one json object, quantum is time_not_set for policies without one
+        void write_json(std::ostream& out, const std::string& policy, 
+            osp2023::time_type quantum, std::size_t numProcesses) const;
+};
+
+// the recorder for the timed run, it only moves the stats from the prepare phase
+// to the schedule phase. it isn't enabled, so simulate still takes the batch
+// kernels and the times and hardware counts are of the code a plain run runs
+class stats_phases
+{
+    private:
+        stats_recorder& stats;
+    public:
+        static constexpr bool enabled = false;
+
+        explicit stats_phases(stats_recorder& stats): stats(stats) {}
+
+        void prepared(const process_table&)
+        {
+            stats.begin_phase(STATS_PHASE_SCHEDULE);
+        }
+
+        void record(std::size_t, osp2023::id_type, osp2023::time_type, osp2023::time_type, bool) {}
+};
+
+#endif
@@ -0,0 +1,97 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+thread_local bool thread_pool::isWorker = false;
+
+thread_pool::thread_pool(std::size_t numThreads): numRunning(0), stopping(false)
+{
+    if (numThreads == 0) {
+        numThreads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    for (std::size_t i = 0; i < numThreads; ++i) {
+        workers.emplace_back(&thread_pool::work, this);
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        stopping = true;
+    }
+    taskReady.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void thread_pool::work()
+{
+    isWorker = true;
+    while (true) {
+        std::function<void()> task;
+        {
+            // wait for something to do, only stop once the queue is drained
+            std::unique_lock<std::mutex> guard(lock);
+            taskReady.wait(guard, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            ++numRunning;
+        }
+
+        // run the task outside the lock
+        std::exception_ptr error;
+        try {
+            task();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            if (error && !firstError) {
+                firstError = error;
+            }
+            --numRunning;
+            if (numRunning == 0 && tasks.empty()) {
+                allDone.notify_all();
+            }
+        }
+    }
+}
+
+void thread_pool::submit(std::function<void()> task)
+{
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        tasks.push_back(std::move(task));
+    }
+    taskReady.notify_one();
+}
+
+void thread_pool::wait()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    allDone.wait(guard, [this] { return numRunning == 0 && tasks.empty(); });
+
+    // hand a failure back to whoever is waiting, only once
+    if (firstError) {
+        std::exception_ptr error = firstError;
+        firstError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+std::size_t thread_pool::size() const
+{
+    return workers.size();
+}
+
+bool thread_pool::on_worker()
+{
+    return isWorker;
+}
@@ -0,0 +1,60 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <cstddef>
+
+/**
+ * a fixed set of worker threads that run submitted tasks in the order they were submitted.
+ * tasks must not share anything mutable with each other, the pool does no locking for them.
+ * if a task throws, the first exception is rethrown from wait().
+ **/
+class thread_pool
+{
+    private:
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+
+        std::mutex lock;
+        // signalled when a task is added or the pool is shutting down
+        std::condition_variable taskReady;
+        // signalled when the last running task finishes
+        std::condition_variable allDone;
+
+        std::size_t numRunning;
+        bool stopping;
+        std::exception_ptr firstError;
+
+        // true on the worker threads of any pool
+        static thread_local bool isWorker;
+
+        void work();
+    public:
+        // numThreads of 0 means one per core
+        explicit thread_pool(std::size_t numThreads = 0);
+        // waits for the queued tasks to finish
+        ~thread_pool();
+
+        thread_pool(const thread_pool& other) = delete;
+        thread_pool& operator=(const thread_pool& other) = delete;
+
+        void submit(std::function<void()> task);
+
+        // block until every submitted task has finished
+        void wait();
+
+        std::size_t size() const;
+
+        // is this thread one of a pool's workers, a task that would split its own
+        // work over a new pool should just do it on this thread instead, the pool
+        // it's on already has every core busy
+        static bool on_worker();
+};
+
+#endif
@@ -0,0 +1,93 @@
+#include "timeline.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include "buffered_writer.h"
+
+#define CHROME_TRACE_EXTENSION ".json"
+
+timeline_recorder::timeline_recorder(): used(TIMELINE_CHUNK_RECORDS) {};
+
+void timeline_recorder::add_chunk()
+{
+    chunks.push_back(std::make_unique<dispatch_record[]>(TIMELINE_CHUNK_RECORDS));
+    used = 0;
+}
+
+std::size_t timeline_recorder::size() const
+{
+    if (chunks.empty()) {
+        return 0;
+    }
+    return (chunks.size() - 1) * TIMELINE_CHUNK_RECORDS + used;
+}
+
+const dispatch_record& timeline_recorder::at(std::size_t index) const
+{
+    return chunks[index / TIMELINE_CHUNK_RECORDS][index % TIMELINE_CHUNK_RECORDS];
+}
+
+void timeline_recorder::write_chrome_trace(std::ostream& out) const
+{
+    // one complete ("X") event per slice, every slice on the same cpu row
+    // chrome reads ts and dur as microseconds, so one time unit shows as 1us
+    buffered_writer writer(out);
+    auto text = [&writer](const char* value) { writer.write(value, strlen(value)); };
+
+    text("{\"traceEvents\":[");
+    for (std::size_t i = 0; i < size(); ++i) {
+        const dispatch_record& slice = at(i);
+        text(i == 0 ? "\n" : ",\n");
+        text("{\"name\":\"P");
+        writer.write_left(slice.process, 0);
+        text("\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":");
+        writer.write_left(slice.start, 0);
+        text(",\"dur\":");
+        writer.write_left(slice.end - slice.start, 0);
+        text(",\"args\":{\"process\":");
+        writer.write_left(slice.process, 0);
+        text(slice.finished ? ",\"finished\":true}}" : ",\"finished\":false}}");
+    }
+    text("\n]}\n");
+}
+
+void timeline_recorder::write_binary(std::ostream& out) const
+{
+    timeline_header header = {};
+    memcpy(header.magic, TIMELINE_MAGIC, TIMELINE_MAGIC_LEN);
+    header.version = TIMELINE_VERSION;
+    header.recordSize = sizeof(dispatch_record);
+    header.numRecords = size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // the chunks are already laid out as they go on disk
+    for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+        std::size_t numRecords = (chunk + 1 == chunks.size()) ? used : TIMELINE_CHUNK_RECORDS;
+        out.write(reinterpret_cast<const char*>(chunks[chunk].get()), 
+            numRecords * sizeof(dispatch_record));
+    }
+}
+
+void timeline_recorder::save(const std::string& fileName) const
+{
+    std::ofstream file(fileName, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!file) {
+        std::string error = "ERROR : timeline : could not write to file \"" + fileName + "\"";
+        throw std::runtime_error(error);
+    }
+
+    std::string extension = CHROME_TRACE_EXTENSION;
+    bool chromeTrace = fileName.size() >= extension.size() &&
+        fileName.compare(fileName.size() - extension.size(), extension.size(), extension) == 0;
+    if (chromeTrace) {
+        write_chrome_trace(file);
+    } else {
+        write_binary(file);
+    }
+
+    if (!file) {
+        std::string error = "ERROR : timeline : could not write to file \"" + fileName + "\"";
+        throw std::runtime_error(error);
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <vector>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include "types.h"
+#include "process_table.h"
+
+// records are kept in fixed size chunks, so recording never moves old records
+#define TIMELINE_CHUNK_RECORDS (1 << 16)
+
+// a binary timeline starts with this header, then every record in order
+#define TIMELINE_MAGIC "OSPTLINE"
+#define TIMELINE_MAGIC_LEN 8
+#define TIMELINE_VERSION 1
+
+struct timeline_header {
+    char magic[TIMELINE_MAGIC_LEN];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint64_t numRecords;
+};
+
+// one slice of cpu time, the same layout in memory and in a binary timeline
+struct dispatch_record {
+    osp2023::time_type start;
+    osp2023::time_type end;
+    osp2023::id_type process;
+    // 1 if the process finished at the end of the slice, 0 if it was preempted
+    std::uint8_t finished;
+    std::uint8_t reserved[3];
+};
+static_assert(sizeof(dispatch_record) == 24, "dispatch_record should have no padding");
+
+/**
+ * records every slice of cpu time handed out by simulate<Policy>, in the order
+ * they were handed out. records go into a chunked arena, a new chunk is only
+ * allocated every TIMELINE_CHUNK_RECORDS records, so recording is a store and
+ * an increment. pass a null_recorder instead to record nothing at no cost.
+ **/
+class timeline_recorder
+{
+    private:
+        std::vector<std::unique_ptr<dispatch_record[]>> chunks;
+        // records used in the last chunk
+        std::size_t used;
+
+        void add_chunk();
+    public:
+        static constexpr bool enabled = true;
+
+        timeline_recorder();
+
+        void prepared(const process_table&) {}
+
+        void record(std::size_t, osp2023::id_type process, osp2023::time_type start,
+            osp2023::time_type end, bool finished)
+        {
+            if (used == TIMELINE_CHUNK_RECORDS) {
+                add_chunk();
+            }
+            chunks.back()[used++] = {start, end, process, finished, {}};
+        }
+
+        std::size_t size() const;
+        // the record at index, in the order they were recorded
+        const dispatch_record& at(std::size_t index) const;
+
+        // chrome trace event json, load it in chrome://tracing or perfetto
+        void write_chrome_trace(std::ostream& out) const;
+        // the header followed by the raw records
+        void write_binary(std::ostream& out) const;
+
+        // write to fileName, as chrome trace json if it ends in .json and binary otherwise
+        void save(const std::string& fileName) const;
+};
+
+#endif
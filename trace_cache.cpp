@@ -0,0 +1,75 @@
+#include "trace_cache.h"
+#include "loader.h"
+#include "workload_generator.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <sys/stat.h>
+
+trace_cache::trace_cache(std::size_t maxTraces):
+    maxTraces(std::max<std::size_t>(1, maxTraces)), numLookups(0) {};
+
+std::shared_ptr<const process_table> trace_cache::get(const std::string& fileName, bool& cached)
+{
+    // a gen: spec always makes the same workload, so it never changes
+    std::int64_t mtime = 0;
+    std::int64_t size = 0;
+    if (!workload_generator::is_spec(fileName)) {
+        struct stat info;
+        if (stat(fileName.c_str(), &info) != 0) {
+            std::string error = "ERROR : loader : file \"" + fileName + "\" does not exist";
+            throw std::runtime_error(error);
+        }
+        mtime = static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+        size = info.st_size;
+    }
+
+    std::promise<std::shared_ptr<const process_table>> loaded;
+    std::shared_future<std::shared_ptr<const process_table>> table;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        ++numLookups;
+
+        auto found = traces.find(fileName);
+        cached = found != traces.end() && found->second.mtime == mtime && found->second.size == size;
+        if (cached) {
+            found->second.lastUsed = numLookups;
+            table = found->second.table;
+        } else {
+            // make room for it, anyone still using the old table keeps their copy
+            if (found == traces.end() && traces.size() >= maxTraces) {
+                auto oldest = traces.begin();
+                for (auto it = traces.begin(); it != traces.end(); ++it) {
+                    if (it->second.lastUsed < oldest->second.lastUsed) {
+                        oldest = it;
+                    }
+                }
+                traces.erase(oldest);
+            }
+
+            // put the future in before loading, so other threads wait for this load
+            entry& slot = traces[fileName];
+            slot.mtime = mtime;
+            slot.size = size;
+            slot.lastUsed = numLookups;
+            slot.table = loaded.get_future().share();
+            table = slot.table;
+        }
+    }
+
+    if (!cached) {
+        // the load happens outside the lock so other traces can be found meanwhile
+        try {
+            loaded.set_value(std::make_shared<const process_table>(loader::load(fileName)));
+        } catch (...) {
+            // don't keep the failure around, the next request tries again
+            loaded.set_exception(std::current_exception());
+            std::lock_guard<std::mutex> guard(lock);
+            auto found = traces.find(fileName);
+            if (found != traces.end() && found->second.mtime == mtime && found->second.size == size) {
+                traces.erase(found);
+            }
+        }
+    }
+    return table.get();
+}
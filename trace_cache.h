@@ -0,0 +1,47 @@
+#ifndef TRACE_CACHE_H
+#define TRACE_CACHE_H
+
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <future>
+#include <cstddef>
+#include <cstdint>
+#include "process_table.h"
+
+// keep at most this many traces loaded, the least recently used one goes first
+#define TRACE_CACHE_DEFAULT_SIZE 64
+
+/**
+ * keeps loaded traces in memory so they don't have to be read and parsed
+ * again for every run. a trace is found by its path and is loaded again if
+ * the file's mtime or size has changed since. safe to use from many threads,
+ * if several ask for the same trace at once it is only loaded once and the
+ * rest wait for it. the tables handed out are shared and must not be changed.
+ **/
+class trace_cache
+{
+    private:
+        struct entry {
+            // the file as it was when it was loaded, both 0 for gen: specs
+            std::int64_t mtime = 0;
+            std::int64_t size = 0;
+            std::shared_future<std::shared_ptr<const process_table>> table;
+            std::uint64_t lastUsed = 0;
+        };
+
+        std::size_t maxTraces;
+        std::mutex lock;
+        std::map<std::string, entry> traces;
+        // counts every lookup, so the entries can say when they were last used
+        std::uint64_t numLookups;
+    public:
+        explicit trace_cache(std::size_t maxTraces = TRACE_CACHE_DEFAULT_SIZE);
+
+        // the trace at fileName, loading it if it isn't cached or has changed
+        // throws the same errors as loader::load, cached set to whether it was already loaded
+        std::shared_ptr<const process_table> get(const std::string& fileName, bool& cached);
+};
+
+#endif
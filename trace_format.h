@@ -0,0 +1,50 @@
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * the binary columnar trace format written by csv2bin.
+ *
+ * layout (native byte order):
+ *   trace_header
+ *   id column     - numProcesses x int32, then zero padding to an 8 byte boundary
+ *   burst column  - numProcesses x int64, then zero padding to an 8 byte boundary
+ *   arrival column (optional) - numProcesses x int64, padded the same way
+ *   weight column (optional)  - numProcesses x int64, padded the same way
+ *
+ * the columns flag says which columns follow the header, in bit order,
+ * so more optional columns can be added without breaking old files.
+ **/
+
+#define TRACE_MAGIC "OSPTRACE"
+#define TRACE_MAGIC_LEN 8
+#define TRACE_VERSION 1
+
+// column flags
+#define TRACE_COL_ID (1u << 0)
+#define TRACE_COL_BURST (1u << 1)
+#define TRACE_COL_ARRIVAL (1u << 2)
+#define TRACE_COL_WEIGHT (1u << 3)
+#define TRACE_REQUIRED_COLS (TRACE_COL_ID | TRACE_COL_BURST)
+#define TRACE_KNOWN_COLS (TRACE_REQUIRED_COLS | TRACE_COL_ARRIVAL | TRACE_COL_WEIGHT)
+
+// every column starts on this boundary
+#define TRACE_COL_ALIGN 8
+
+struct trace_header {
+    char magic[TRACE_MAGIC_LEN];
+    std::uint32_t version;
+    std::uint32_t columns;
+    std::uint64_t numProcesses;
+};
+
+// the number of bytes a column of numProcesses elementSize values takes, padding included
+inline std::size_t trace_column_bytes(std::uint64_t numProcesses, std::size_t elementSize)
+{
+    std::size_t bytes = numProcesses * elementSize;
+    return (bytes + TRACE_COL_ALIGN - 1) / TRACE_COL_ALIGN * TRACE_COL_ALIGN;
+}
+
+#endif
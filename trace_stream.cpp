@@ -0,0 +1,133 @@
+#include "trace_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+trace_stream::trace_stream(const std::string& fileName):
+    fileName(fileName), kind(source::CSV), arrivalTimes(false), hasPending(false),
+    buffered(0), linesRead(0), endOfFile(false), nextRow(0)
+{
+    // synthetic workloads are made a block at a time
+    if (workload_generator::is_spec(fileName)) {
+        workload_spec spec = workload_generator::parse_spec(fileName);
+        kind = source::GENERATOR;
+        arrivalTimes = spec.meanArrivalGap > 0;
+        generator = std::make_unique<workload_generator>(spec);
+        return;
+    }
+
+    if (loader::is_binary(fileName)) {
+        if (!mapping.map(fileName)) {
+            std::string error = "ERROR : loader : file \"" + fileName + "\" does not exist";
+            throw std::runtime_error(error);
+        }
+        kind = source::BINARY;
+        columns = loader::map_binary(mapping, fileName);
+        // csv2bin leaves the column out if every process arrives at 0
+        arrivalTimes = columns.arrivalTimes != nullptr;
+        return;
+    }
+
+    file.open(fileName, std::ifstream::in | std::ifstream::binary);
+    if (!file.is_open()) {
+        std::string error = "ERROR : loader : file \"" + fileName + "\" does not exist";
+        throw std::runtime_error(error);
+    }
+    buffer.resize(STREAM_READ_BYTES);
+
+    // the first batch is the best guess there is at whether the trace has arrival times
+    hasPending = next_csv_batch(pending);
+    arrivalTimes = pending.hasArrivalTimes();
+}
+
+bool trace_stream::fill_buffer()
+{
+    if (endOfFile) {
+        return false;
+    }
+
+    // a line longer than the whole buffer needs a bigger one
+    if (buffered == buffer.size()) {
+        buffer.resize(buffer.size() * 2);
+    }
+
+    file.read(buffer.data() + buffered, buffer.size() - buffered);
+    std::size_t numRead = file.gcount();
+    if (numRead == 0) {
+        endOfFile = true;
+        return false;
+    }
+    buffered += numRead;
+    return true;
+}
+
+bool trace_stream::next_csv_batch(process_table& batch)
+{
+    // fill the buffer up and cut it after the last whole line
+    const char* cut = nullptr;
+    while (cut == nullptr) {
+        while (buffered < buffer.size() && fill_buffer()) {}
+        if (buffered == 0) {
+            return false;
+        }
+
+        if (endOfFile) {
+            // the last line doesn't need a newline
+            cut = buffer.data() + buffered;
+        } else {
+            const char* newline = static_cast<const char*>(memrchr(buffer.data(), '\n', buffered));
+            if (newline != nullptr) {
+                cut = newline + 1;
+            } else {
+                // not even one whole line yet, read more of it
+                fill_buffer();
+            }
+        }
+    }
+
+    batch = process_table();
+    linesRead += loader::parse_lines(buffer.data(), cut, batch, linesRead);
+
+    // keep the part line for next time
+    std::size_t numUsed = cut - buffer.data();
+    memmove(buffer.data(), cut, buffered - numUsed);
+    buffered -= numUsed;
+    return true;
+}
+
+bool trace_stream::next_batch(process_table& batch)
+{
+    if (hasPending) {
+        batch = std::move(pending);
+        hasPending = false;
+        return true;
+    }
+    return read_batch(batch);
+}
+
+bool trace_stream::read_batch(process_table& batch)
+{
+    switch (kind) {
+        case source::GENERATOR:
+            return generator->next_block(batch);
+        case source::BINARY:
+        {
+            if (nextRow >= columns.numProcesses) {
+                return false;
+            }
+            std::size_t lastRow = std::min(columns.numProcesses, nextRow + STREAM_BATCH_ROWS);
+            batch = loader::copy_binary(columns, nextRow, lastRow, fileName);
+            nextRow = lastRow;
+            return true;
+        }
+        case source::CSV:
+        default:
+            return next_csv_batch(batch);
+    }
+}
+
+bool trace_stream::hasArrivalTimes() const
+{
+    return arrivalTimes;
+}
@@ -0,0 +1,75 @@
+#ifndef TRACE_STREAM_H
+#define TRACE_STREAM_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <memory>
+#include <cstddef>
+#include "types.h"
+#include "process_table.h"
+#include "mapped_file.h"
+#include "loader.h"
+#include "workload_generator.h"
+
+// about this many processes are handed out in each batch
+#define STREAM_BATCH_ROWS (1 << 16)
+// a CSV is read this many bytes at a time
+#define STREAM_READ_BYTES (1 << 20)
+
+/**
+ * reads a trace a batch at a time instead of all at once, so only one batch
+ * has to be in memory however big the trace is. it takes the same files as
+ * loader::load (CSV, binary traces and gen: specs) and gives the same
+ * processes in the same order with the same error messages.
+ **/
+class trace_stream
+{
+    private:
+        enum class source {
+            CSV,
+            BINARY,
+            GENERATOR
+        };
+
+        std::string fileName;
+        source kind;
+        bool arrivalTimes;
+
+        // the first batch is read straight away to look for arrival times
+        process_table pending;
+        bool hasPending;
+
+        // a CSV is read in blocks, the part line at the end of a block is
+        // kept at the front of the buffer until the rest of it is read
+        std::ifstream file;
+        std::vector<char> buffer;
+        std::size_t buffered;
+        std::size_t linesRead;
+        bool endOfFile;
+
+        // a binary trace is mapped and copied out a batch of rows at a time
+        mapped_file mapping;
+        binary_columns columns;
+        std::size_t nextRow;
+
+        std::unique_ptr<workload_generator> generator;
+
+        // top up the buffer from the file, false if there was nothing left to read
+        bool fill_buffer();
+        bool next_csv_batch(process_table& batch);
+        bool read_batch(process_table& batch);
+    public:
+        // open the trace, throws the same errors loader::load would if it can't
+        explicit trace_stream(const std::string& fileName);
+
+        // replace batch with the next processes in the trace, false once there are none left
+        bool next_batch(process_table& batch);
+
+        // whether some process arrives after 0, the same as hasArrivalTimes() on the
+        // table loader::load gives for binary traces and gen: specs which say so up front
+        // a CSV can't be checked without reading all of it, so only the first batch counts
+        bool hasArrivalTimes() const;
+};
+
+#endif
@@ -4,9 +4,12 @@ namespace osp2023 {
 // renaming some types so that the types are more meaningful
 using time_type = long long;
 using id_type = int;
+using weight_type = long long;
 // constant that can be used to initialise a time to not having been set
 // CHANGE: extern to static
 static constexpr time_type time_not_set = -1;
 static constexpr time_type time_zero = 0;
+// the weight of a process that didn't get one, the same as a nice 0 task in linux
+static constexpr weight_type default_weight = 1024;
 }
 #endif
@@ -0,0 +1,240 @@
+#include "workload_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include "pcb.h"
+#include "thread_pool.h"
+
+namespace {
+    // a double in [0, 1) from the top 53 bits, so the workload doesn't depend
+    // on how a standard library implements its distributions
+    double unit(std::mt19937_64& rng)
+    {
+        return (rng() >> 11) * 0x1.0p-53;
+    }
+
+    // exponential with the given mean, by inverting its cdf
+    double exponential(std::mt19937_64& rng, double mean)
+    {
+        return -mean * std::log(1.0 - unit(rng));
+    }
+
+    // normal with the given mean and standard deviation, by box-muller
+    double normal(std::mt19937_64& rng, double mean, double stdDev)
+    {
+        double radius = std::sqrt(-2.0 * std::log(1.0 - unit(rng)));
+        double angle = 2.0 * std::numbers::pi * unit(rng);
+        return mean + stdDev * radius * std::cos(angle);
+    }
+
+    osp2023::time_type clamp_burst(double burstTime)
+    {
+        // clamp before rounding so huge pareto draws can't overflow
+        burstTime = std::clamp(burstTime,
+            static_cast<double>(pcb::MIN_DURATION), static_cast<double>(pcb::MAX_DURATION));
+        return std::llround(burstTime);
+    }
+}
+
+workload_generator::workload_generator(const workload_spec& spec):
+    spec(spec), nextBlock(0), nextArrival(osp2023::time_zero) {};
+
+bool workload_generator::is_spec(const std::string& text)
+{
+    return text.rfind(GEN_SPEC_PREFIX, 0) == 0;
+}
+
+workload_spec workload_generator::parse_spec(const std::string& text)
+{
+    std::string usage = "ERROR : generator : spec should be " GEN_SPEC_PREFIX
+        "<uniform|exponential|bimodal|pareto>:<processes>[:<seed>[:<mean arrival gap>]]";
+    if (!is_spec(text)) {
+        throw std::runtime_error(usage);
+    }
+
+    // split what comes after the prefix into fields
+    std::vector<std::string> fields;
+    std::size_t start = std::string(GEN_SPEC_PREFIX).size();
+    while (true) {
+        std::size_t end = text.find(GEN_SPEC_DELIMITER, start);
+        fields.push_back(text.substr(start, end - start));
+        if (end == std::string::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+    if (fields.size() < 2 || fields.size() > 4) {
+        throw std::runtime_error(usage);
+    }
+
+    workload_spec spec;
+    if (fields[0] == "uniform") {
+        spec.distribution = burst_distribution::UNIFORM;
+    } else if (fields[0] == "exponential") {
+        spec.distribution = burst_distribution::EXPONENTIAL;
+    } else if (fields[0] == "bimodal") {
+        spec.distribution = burst_distribution::BIMODAL;
+    } else if (fields[0] == "pareto") {
+        spec.distribution = burst_distribution::PARETO;
+    } else {
+        throw std::runtime_error("ERROR : generator : unknown distribution \"" + fields[0] + "\"");
+    }
+
+    // the numbers have to be whole fields, stoull alone would take "10abc"
+    try {
+        std::size_t used = 0;
+        if (fields[1].empty() || fields[1][0] == '-') {
+            throw std::invalid_argument(fields[1]);
+        }
+        spec.numProcesses = std::stoull(fields[1], &used);
+        if (used != fields[1].size()) {
+            throw std::invalid_argument(fields[1]);
+        }
+        if (fields.size() > 2) {
+            spec.seed = std::stoull(fields[2], &used);
+            if (used != fields[2].size()) {
+                throw std::invalid_argument(fields[2]);
+            }
+        }
+        if (fields.size() > 3) {
+            spec.meanArrivalGap = std::stod(fields[3], &used);
+            if (used != fields[3].size() || !(spec.meanArrivalGap >= 0)) {
+                throw std::invalid_argument(fields[3]);
+            }
+        }
+    } catch (const std::logic_error& e) {
+        throw std::runtime_error(usage);
+    }
+
+    // like an unknown distribution, a count of 0 is almost always a typo
+    if (spec.numProcesses == 0) {
+        throw std::runtime_error("ERROR : generator : need at least 1 process");
+    }
+
+    // process ids have to fit, and start at 1
+    if (spec.numProcesses > static_cast<std::size_t>(std::numeric_limits<osp2023::id_type>::max())) {
+        throw std::runtime_error("ERROR : generator : too many processes for a process id");
+    }
+    return spec;
+}
+
+std::size_t workload_generator::block_rows(const workload_spec& spec, std::size_t block)
+{
+    std::size_t start = block * GEN_BLOCK_SIZE;
+    return std::min<std::size_t>(GEN_BLOCK_SIZE, spec.numProcesses - start);
+}
+
+void workload_generator::fill_block(const workload_spec& spec, std::size_t block,
+    osp2023::id_type* ids, osp2023::time_type* burstTimes, osp2023::time_type* arrivalGaps)
+{
+    // every block gets its own stream from the seed and the block number
+    std::seed_seq seeds = {
+        static_cast<std::uint32_t>(spec.seed), static_cast<std::uint32_t>(spec.seed >> 32),
+        static_cast<std::uint32_t>(block), static_cast<std::uint32_t>(block >> 32)
+    };
+    std::mt19937_64 rng(seeds);
+
+    std::size_t start = block * GEN_BLOCK_SIZE;
+    std::size_t numRows = block_rows(spec, block);
+    for (std::size_t i = 0; i < numRows; ++i) {
+        ids[i] = static_cast<osp2023::id_type>(start + i + 1);
+
+        double burstTime = 0;
+        switch (spec.distribution) {
+            case burst_distribution::UNIFORM:
+                burstTime = pcb::MIN_DURATION +
+                    static_cast<double>(rng() % (pcb::MAX_DURATION - pcb::MIN_DURATION + 1));
+                break;
+            case burst_distribution::EXPONENTIAL:
+                burstTime = exponential(rng, GEN_EXPONENTIAL_MEAN);
+                break;
+            case burst_distribution::BIMODAL:
+                if (unit(rng) < GEN_BIMODAL_LONG_CHANCE) {
+                    burstTime = normal(rng, GEN_BIMODAL_LONG_MEAN, GEN_BIMODAL_LONG_STD_DEV);
+                } else {
+                    burstTime = normal(rng, GEN_BIMODAL_SHORT_MEAN, GEN_BIMODAL_SHORT_STD_DEV);
+                }
+                break;
+            case burst_distribution::PARETO:
+                burstTime = pcb::MIN_DURATION / std::pow(1.0 - unit(rng), 1.0 / GEN_PARETO_SHAPE);
+                break;
+        }
+        burstTimes[i] = clamp_burst(burstTime);
+
+        arrivalGaps[i] = (spec.meanArrivalGap > 0) ?
+            std::llround(exponential(rng, spec.meanArrivalGap)) : osp2023::time_zero;
+    }
+}
+
+process_table workload_generator::generate(const workload_spec& spec)
+{
+    std::vector<osp2023::id_type> ids(spec.numProcesses);
+    std::vector<osp2023::time_type> burstTimes(spec.numProcesses);
+    std::vector<osp2023::time_type> arrivalTimes(spec.numProcesses);
+
+    // the blocks don't share anything, so they can all be made at once
+    std::size_t numBlocks = (spec.numProcesses + GEN_BLOCK_SIZE - 1) / GEN_BLOCK_SIZE;
+    auto fill = [&](std::size_t block) {
+        std::size_t start = block * GEN_BLOCK_SIZE;
+        fill_block(spec, block, ids.data() + start, burstTimes.data() + start, arrivalTimes.data() + start);
+    };
+    if (numBlocks < 2) {
+        for (std::size_t block = 0; block < numBlocks; ++block) {
+            fill(block);
+        }
+    } else {
+        thread_pool pool;
+        for (std::size_t block = 0; block < numBlocks; ++block) {
+            pool.submit([&fill, block] { fill(block); });
+        }
+        pool.wait();
+    }
+
+    // each process arrives once every gap before it has passed, the first at 0
+    if (spec.meanArrivalGap > 0) {
+        std::exclusive_scan(arrivalTimes.begin(), arrivalTimes.end(),
+            arrivalTimes.begin(), osp2023::time_zero);
+    } else {
+        arrivalTimes.clear();
+    }
+
+    return process_table(std::move(ids), std::move(burstTimes), std::move(arrivalTimes));
+}
+
+bool workload_generator::next_block(process_table& batch)
+{
+    if (done()) {
+        return false;
+    }
+
+    std::size_t numRows = block_rows(spec, nextBlock);
+    std::vector<osp2023::id_type> ids(numRows);
+    std::vector<osp2023::time_type> burstTimes(numRows);
+    std::vector<osp2023::time_type> arrivalTimes(numRows);
+    fill_block(spec, nextBlock, ids.data(), burstTimes.data(), arrivalTimes.data());
+    ++nextBlock;
+
+    // carry the arrival times on from the end of the last block
+    if (spec.meanArrivalGap > 0) {
+        for (std::size_t i = 0; i < numRows; ++i) {
+            osp2023::time_type gap = arrivalTimes[i];
+            arrivalTimes[i] = nextArrival;
+            nextArrival += gap;
+        }
+    } else {
+        arrivalTimes.clear();
+    }
+
+    batch = process_table(std::move(ids), std::move(burstTimes), std::move(arrivalTimes));
+    return true;
+}
+
+bool workload_generator::done() const
+{
+    return nextBlock * GEN_BLOCK_SIZE >= spec.numProcesses;
+}
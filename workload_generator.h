@@ -0,0 +1,82 @@
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "types.h"
+#include "process_table.h"
+
+// a file name starting with this is a generator spec instead of a file
+// gen:<distribution>:<processes>[:<seed>[:<mean arrival gap>]]
+#define GEN_SPEC_PREFIX "gen:"
+#define GEN_SPEC_DELIMITER ':'
+#define GEN_DEFAULT_SEED 2023
+
+// processes are made in blocks, each with its own random stream, so a block
+// comes out the same whether it is made alone, in a stream or on another thread
+#define GEN_BLOCK_SIZE (1 << 16)
+
+// exponential bursts average this before clamping
+#define GEN_EXPONENTIAL_MEAN 100.0
+// bimodal bursts are mostly short with some long ones
+#define GEN_BIMODAL_SHORT_MEAN 30.0
+#define GEN_BIMODAL_SHORT_STD_DEV 10.0
+#define GEN_BIMODAL_LONG_MEAN 800.0
+#define GEN_BIMODAL_LONG_STD_DEV 100.0
+#define GEN_BIMODAL_LONG_CHANCE 0.2
+// pareto bursts start at MIN_DURATION, a shape of 1.16 is the 80/20 rule
+#define GEN_PARETO_SHAPE 1.16
+
+enum class burst_distribution {
+    UNIFORM,
+    EXPONENTIAL,
+    BIMODAL,
+    PARETO
+};
+
+// everything needed to make the same workload again
+struct workload_spec {
+    burst_distribution distribution = burst_distribution::UNIFORM;
+    std::size_t numProcesses = 0;
+    std::uint64_t seed = GEN_DEFAULT_SEED;
+    // 0 means every process arrives at 0, otherwise the gaps between
+    // arrivals are exponential with this mean
+    double meanArrivalGap = 0;
+};
+
+/**
+ * makes seeded synthetic workloads with burst times clamped to
+ * pcb::MIN_DURATION and pcb::MAX_DURATION. the same spec always gives the
+ * same processes. a workload can be made all at once, or a block at a time
+ * so workloads far bigger than memory can be streamed.
+ **/
+class workload_generator
+{
+    private:
+        workload_spec spec;
+        std::size_t nextBlock;
+        osp2023::time_type nextArrival;
+
+        // fill in the ids, burst times and gaps to the next arrival for one block
+        static void fill_block(const workload_spec& spec, std::size_t block,
+            osp2023::id_type* ids, osp2023::time_type* burstTimes, osp2023::time_type* arrivalGaps);
+        static std::size_t block_rows(const workload_spec& spec, std::size_t block);
+    public:
+        explicit workload_generator(const workload_spec& spec);
+
+        // is this file name a generator spec
+        static bool is_spec(const std::string& text);
+        // read a gen:... spec, throws if it is malformed
+        static workload_spec parse_spec(const std::string& text);
+
+        // the whole workload at once, blocks are made on every core
+        static process_table generate(const workload_spec& spec);
+
+        // replace batch with the next block of processes, false once there are none left
+        bool next_block(process_table& batch);
+        bool done() const;
+};
+
+#endif